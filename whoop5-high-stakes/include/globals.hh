@@ -24,10 +24,27 @@
 
 
 // Odometry Parameters
-#define WHEEL_DIAMETER 63.89_mm        // Diameter of forward and sideways wheel
+#define FORWARD_WHEEL_DIAMETER 63.89_mm // Diameter of the forward wheel
+#define LATERAL_WHEEL_DIAMETER 63.89_mm // Diameter of the sideways wheel
 #define FORWARD_WHEEL_OFFSET -1.125_in // How far to the right of the center of the robot the forward wheel is
 #define LATERAL_WHEEL_OFFSET -1_in     // How far to the rear of the robot the lateral wheel is from the center
 
+// Drive geometry. Odometry checks the sensors above against the drive motors, and falls back on the motors if one fails mid-match
+#define DRIVE_WHEEL_DIAMETER 3.25_in // Diameter of the drive wheels
+#define DRIVE_GEAR_RATIO 0.75        // Drive wheel turns per motor turn
+#define DRIVE_TRACK_WIDTH 12_in      // Distance between the left and right drive wheels
+
+// set to true to print a line of CSV for every reckless tick, for plotting a run from the terminal. leave off for competitions
+#define CAPTURE_TELEMETRY false
+
+// set to true to record the raw odometry sensors to the SD card, so runs can be replayed on a computer with tools/odometry_replay.cpp
+#define CAPTURE_ODOMETRY false
+#define ODOMETRY_LOG_PATH "/usd/odometry.bin"
+
+// set to true to measure the odometry constants above at the start of opcontrol. see calibrate_odometry() in main.cpp
+#define CALIBRATE_ODOMETRY false
+#define CALIBRATION_DISTANCE 48_in // length of the straight lines driven while calibrating
+
 
 
 // tuning constants. These values are determined through a lot of testing
@@ -37,9 +54,9 @@
 
 // background threads
 // https://pros.cs.purdue.edu/v5/tutorials/topical/multitasking.html
-extern std::shared_ptr<rev::AsyncRunner> odom_runner;     // calculates robot's position in the background
-extern std::shared_ptr<rev::AsyncRunner> reckless_runner; // controls the chassis in the background
-extern std::shared_ptr<rev::AsyncRunner> turn_runner;     // does point turns in the background
+extern std::shared_ptr<rev::Scheduler> scheduler; // runs odometry, then reckless and turn, every 10ms in one background thread
+extern std::shared_ptr<rev::AsyncRunner> telemetry_runner; // prints recorded telemetry at low priority so printing never slows the controllers, when CAPTURE_TELEMETRY is on
+extern std::shared_ptr<rev::AsyncRunner> odometry_log_runner; // writes captured odometry sensor readings to the SD card, when CAPTURE_ODOMETRY is on
 
 
 // controllers
@@ -47,6 +64,9 @@ extern std::shared_ptr<rev::TwoRotationInertialOdometry> odom; // tracks global
 extern std::shared_ptr<rev::SkidSteerChassis> chassis;         // controls the motors
 extern std::shared_ptr<rev::Reckless> reckless;                // drives the robot to points on the field
 extern std::shared_ptr<rev::CampbellTurn> turn;                // point turns
+extern std::shared_ptr<rev::Sequencer> sequencer;              // runs autonomous routines built from actions
+extern std::shared_ptr<rev::TelemetryRing> telemetry;          // reckless records its state here every tick, when CAPTURE_TELEMETRY is on
+extern std::shared_ptr<rev::OdometryLogRing> odometry_log;     // odometry captures its raw sensor readings here
 
 
 // motor groups
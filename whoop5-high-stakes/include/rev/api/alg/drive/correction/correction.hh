@@ -1,5 +1,5 @@
 #pragma once
-#include "rev/api/alg/odometry/odometry.hh"
+#include "rev/api/alg/drive/segment_frame.hh"
 
 #include <tuple>
 
@@ -13,18 +13,12 @@ class Correction {
   /**
    * @brief Applies correction to the input
    *
-   * @param current_state The current OdometryState
-   * @param target_state The position being targeted
-   * @param start_state The state of the robot when the active segment began
-   * @param drop_early The distance from the segment target point at which this segment will halt
+   * @param frame The robot's state measured against the current segment
    * @param powers The input powers
    * @return std::tuple<double, double> The adjusted powers
    */
   virtual std::tuple<double, double> apply_correction(
-      OdometryState current_state,
-      Position target_state,
-      Position start_state,
-      QLength drop_early,
+      const SegmentFrame& frame,
       std::tuple<double, double> powers) = 0;
 };
 }  // namespace rev
\ No newline at end of file
@@ -10,21 +10,17 @@ namespace rev {
  * which does not rely on correction whatsoever
  *
  */
-class NoCorrection : public Correction {
+class NoCorrection final : public Correction {
  public:
   /**
    * @brief Applies correction to the input
    *
-   * @param current_state
-   * @param target_state
+   * @param frame
    * @param powers
    * @return std::tuple<double, double>
    */
   std::tuple<double, double> apply_correction(
-      OdometryState current_state,
-      Position target_state,
-      Position start_state,
-      QLength drop_early,
+      const SegmentFrame& frame,
       std::tuple<double, double> powers) override;
 };
 }  // namespace rev
\ No newline at end of file
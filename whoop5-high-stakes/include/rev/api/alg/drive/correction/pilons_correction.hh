@@ -22,21 +22,17 @@ namespace rev {
  * right power by `exp(-correction)`. If `correction < 0`, multiply left power
  * by `exp(correction)`
  */
-class PilonsCorrection : public Correction {
+class PilonsCorrection final : public Correction {
  public:
   /**
    * @brief Applies correction to the input
    *
-   * @param current_state The current OdometryState
-   * @param target_state The position being targeted
+   * @param frame The robot's state measured against the current segment
    * @param powers The input powers
    * @return std::tuple<double, double> The adjusted powers
    */
   std::tuple<double, double> apply_correction(
-      OdometryState current_state,
-      Position target_state,
-      Position start_state,
-      QLength drop_early,
+      const SegmentFrame& frame,
       std::tuple<double, double> powers) override;
 
   /**
@@ -43,12 +43,9 @@ namespace rev {
  * not be used on v5, as the power in the context of ReveilLib is a float
  * [-1.0, 1.0], unlike RobotC's int [-128, 127]
  */
-class CascadingMotion : public Motion {
+class CascadingMotion final : public Motion {
  public:
-  std::tuple<double, double> gen_powers(OdometryState current_state,
-                                        Position target_state,
-                                        Position start_state,
-                                        QLength drop_early) override;
+  std::tuple<double, double> gen_powers(const SegmentFrame& frame) override;
 
   /**
    * @brief Construct a new Cascading Motion controller
@@ -8,12 +8,9 @@ namespace rev {
  * This class takes an input power and just spits out a drive tuple with 2
  * powers of that exact value, like pilons mttSimple
  */
-class ConstantMotion : public Motion {
+class ConstantMotion final : public Motion {
  public:
-  std::tuple<double, double> gen_powers(OdometryState current_state,
-                                        Position target_state,
-                                        Position start_state,
-                                        QLength drop_early) override;
+  std::tuple<double, double> gen_powers(const SegmentFrame& frame) override;
 
   /**
    * @brief Construct a new Constant Motion object
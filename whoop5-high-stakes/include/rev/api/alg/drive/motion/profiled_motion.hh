@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+
+#include "rev/api/alg/drive/motion/motion.hh"
+#include "rev/api/units/all_units.hh"
+
+namespace rev {
+/**
+ * @brief Motion class which follows a trapezoidal velocity profile along the
+ * segment
+ *
+ * When a segment starts, a profile is planned over the distance from the
+ * start point to the drop point. It ramps from the robot's current speed up
+ * to the maximum velocity at the maximum acceleration, cruises, and ramps
+ * back down to stop at the drop point. Short segments never reach the
+ * maximum velocity, and just accelerate then decelerate. Starting from the
+ * current speed lets a blended segment carry its speed in.
+ *
+ * Each step the profile is sampled at the time since the segment started,
+ * and the output power is
+ *
+ * ```cpp
+ * k_v * v_ref + k_a * a_ref + k_p * (s_ref - s) + k_d * (v_ref - v)
+ * ```
+ *
+ * where s is the distance travelled along the line from the start point and
+ * v the velocity along it, in inches and seconds. The feedforward terms do
+ * most of the work, so tune k_v first, as one over the top speed at full
+ * power, then k_a, and only then the feedback gains.
+ *
+ * Once the profile ends only the feedback is left to bring a robot which fell
+ * behind the rest of the way to the drop point. k_p alone would only creep up
+ * on it, slowing as it got closer, and the stop would never see it arrive. So
+ * until it gets there the output is kept to at least the finish power.
+ *
+ * The acceleration limit is what stops the robot wheelieing or slipping when
+ * it launches, and the deceleration ramp is what stops it overshooting short
+ * segments.
+ */
+class ProfiledMotion final : public Motion {
+ public:
+  std::tuple<double, double> gen_powers(const SegmentFrame& frame) override;
+
+  /**
+   * @brief Construct a new Profiled Motion controller
+   *
+   * @param ipower The maximum power the controller will output
+   * @param imax_v The cruising velocity of the profile
+   * @param imax_a The acceleration and deceleration of the profile
+   * @param ik_v Power per in/s of profile velocity
+   * @param ik_a Power per in/s^2 of profile acceleration
+   * @param ik_p Power per inch behind the profile
+   * @param ik_d Power per in/s slower than the profile
+   * @param ifinish_power The least power toward the drop point once the
+   * profile has ended short of it
+   */
+  ProfiledMotion(double ipower,
+                 QSpeed imax_v,
+                 QAcceleration imax_a,
+                 double ik_v,
+                 double ik_a,
+                 double ik_p,
+                 double ik_d = 0.0,
+                 double ifinish_power = 0.1);
+
+ private:
+  /**
+   * @brief Plans the profile for the segment a frame measures
+   *
+   * @param frame
+   */
+  void plan(const SegmentFrame& frame);
+
+  double power;
+  QSpeed max_v;
+  QAcceleration max_a;
+  double k_v;
+  double k_a;
+  double k_p;
+  double k_d;
+  double finish_power;
+
+  // The segment the profile was planned for
+  uint32_t segment_start_time{0};
+  Position segment_start;
+  Position segment_target;
+  bool planned{false};
+
+  // The profile, as speeds along the line, which can't be negative
+  QLength distance;  // Total distance, from the start to the drop point
+  QSpeed v_start;
+  QSpeed v_peak;
+  QAcceleration accel;  // Acceleration to v_peak, negative if slowing to it
+  QAcceleration decel;  // Deceleration from v_peak to a stop, positive
+  QTime accel_time;
+  QTime cruise_time;
+  QTime decel_time;
+};
+}  // namespace rev
\ No newline at end of file
@@ -9,12 +9,9 @@ namespace rev {
  * This could potentially cause issues if the longitudinal error gets to 0
  * outside of the settling area.
  */
-class ProportionalMotion : public Motion {
+class ProportionalMotion final : public Motion {
  public:
-  std::tuple<double, double> gen_powers(OdometryState current_state,
-                                        Position target_state,
-                                        Position start_state,
-                                        QLength drop_early) override;
+  std::tuple<double, double> gen_powers(const SegmentFrame& frame) override;
 
   /**
    * @brief Construct a new Proportional Motion object
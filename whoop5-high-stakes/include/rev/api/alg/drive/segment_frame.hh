@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+
+#include "rev/api/alg/odometry/odometry.hh"
+
+namespace rev {
+
+/**
+ * @brief The geometry of a drive segment relative to the robot, worked out
+ * once per controller step
+ *
+ * Motion, Correction and Stop strategies all measure the robot against the
+ * same line from the start point to the target. Reckless fills one of these
+ * in per step and hands it to each of them, so the trigonometry is done once
+ * rather than in every strategy. Everything which only depends on the segment
+ * is worked out when the segment starts.
+ *
+ * The frame of the line has x along the line toward the target and y to its
+ * right, like the robot's own frame.
+ */
+struct SegmentFrame {
+  // Set by begin(), for the whole segment
+  Position start;
+  Position target;
+  QLength drop_early;
+  PointVector direction;  // Unit vector from start to target, 1 meter long
+  QLength length;         // Distance from start to target
+  QAngle line_angle;      // Heading of the line from start to target
+  // True if the target is behind the robot's heading at the start, so the
+  // segment is driven in reverse
+  bool reversed;
+  // The line angle, turned around if reversed, so that it is the heading
+  // the robot drives the segment at
+  QAngle facing_angle;
+  // When the segment started, in millis. Strategies which keep state compare
+  // this to notice a new segment.
+  uint32_t start_time;
+
+  // Set by update(), each step
+  OdometryState state;
+  // Distance of the robot along the line, relative to the target. This is
+  // negative before the target.
+  QLength along_track;
+  // Distance of the robot to the right of the line
+  QLength cross_track;
+  // Robot heading minus facing_angle, in [-180deg, 180deg)
+  QAngle heading_error;
+  // Distance left along the line to the drop point
+  QLength distance_remaining;
+  // Distance to the target along the robot's heading, negative if the target
+  // is behind the robot
+  QLength target_ahead;
+  QSpeed speed;          // Magnitude of the robot's velocity
+  QSpeed forward_speed;  // Velocity along the robot's heading
+
+  /**
+   * @brief Starts a segment, working out everything that doesn't change
+   * during it
+   *
+   * @param istart Where the robot was when the segment started
+   * @param itarget The target point
+   * @param idrop_early How far before the target the segment ends
+   */
+  void begin(const Position& istart,
+             const Position& itarget,
+             QLength idrop_early);
+
+  /**
+   * @brief Measures the robot against the segment
+   *
+   * @param istate The robot's current state
+   */
+  void update(const OdometryState& istate);
+
+  /**
+   * @brief Fraction of the way from the start to the target, along the line
+   *
+   */
+  double progress() const;
+};
+}  // namespace rev
@@ -9,7 +9,7 @@ namespace rev {
  * @brief Stop controller implementing a simple stopping algorithm
  *
  */
-class SimpleStop : public Stop {
+class SimpleStop final : public Stop {
  public:
   /**
    * @brief Construct a new Simple Stop controller
@@ -50,23 +50,16 @@ class SimpleStop : public Stop {
   /**
    * @brief Find the current stop state
    *
-   * @param current_state The current position and velocity of the robot
-   * @param target_state The position being targeted
-   * @param start_state The place the robot started from
-   * @param drop_early The distance from the target that the robot should aim to
-   * exit this step of the controller
+   * @param frame The robot's state measured against the current segment
    * @return stop_state
    */
-  stop_state get_stop_state(OdometryState current_state,
-                            Position target_state,
-                            Position start_state,
-                            QLength drop_early) override;
+  stop_state get_stop_state(const SegmentFrame& frame) override;
   double get_coast_power() override;
 
  private:
-  const QTime harsh_threshold;
-  const QTime coast_threshold;
-  const double coast_power;
+  QTime harsh_threshold;
+  QTime coast_threshold;
+  double coast_power;
   stop_state stop_state_last{stop_state::GO};
 
   uint32_t time_init {0};
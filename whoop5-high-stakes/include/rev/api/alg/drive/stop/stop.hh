@@ -1,6 +1,6 @@
 #pragma once
 
-#include "rev/api/alg/odometry/odometry.hh"
+#include "rev/api/alg/drive/segment_frame.hh"
 
 namespace rev {
 
@@ -12,10 +12,7 @@ enum class stop_state { GO, COAST, BRAKE, EXIT };
  */
 class Stop {
  public:
-  virtual stop_state get_stop_state(OdometryState current_state,
-                                    Position target_state,
-                                    Position start_state,
-                                    QLength drop_early) = 0;
+  virtual stop_state get_stop_state(const SegmentFrame& frame) = 0;
 
   virtual double get_coast_power() = 0;
 };
@@ -4,6 +4,7 @@
 #include "rev/api/alg/drive/turn/turn.hh"
 #include "rev/api/alg/odometry/odometry.hh"
 #include "rev/api/async/async_awaitable.hh"
+#include "rev/api/async/event.hh"
 #include "rev/api/async/async_runnable.hh"
 #include "rev/api/hardware/chassis/chassis.hh"  // For chassis model
 
@@ -42,6 +43,14 @@ class CampbellTurn : public Turn,
    */
   void await() override;
 
+  /**
+   * @brief Blocks until the current turn completes or the timeout expires
+   *
+   * @param timeout The longest time to wait
+   * @return true if the turn completed
+   */
+  bool await_for(QTime timeout) override;
+
   /**
    * @brief Tells if the controller is working or has completed its motion
    *
@@ -50,6 +59,12 @@ class CampbellTurn : public Turn,
    */
   bool is_completed();
 
+  /**
+   * @brief Ends the current turn immediately and stops the chassis
+   *
+   */
+  void breakout();
+
  private:
   std::shared_ptr<Chassis> chassis;
   std::shared_ptr<Odometry> odometry;
@@ -57,6 +72,7 @@ class CampbellTurn : public Turn,
   double kP2;
   double max_power = 0;
   TurnState controller_state{TurnState::INACTIVE};
+  Event done;  // Set whenever controller_state is INACTIVE
   QAngle angle_difference;
   QAngle target_relative_original;
   QAngle target_relative;
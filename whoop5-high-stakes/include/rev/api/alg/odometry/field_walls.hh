@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+
+#include "rev/util/math/point_vector.hh"
+
+namespace rev {
+
+/**
+ * @brief A straight wall, from start to end
+ *
+ */
+struct WallSegment {
+  PointVector start;
+  PointVector end;
+};
+
+/**
+ * @brief The walls a distance sensor on the field can see, in the field frame
+ *
+ */
+struct FieldWalls {
+  std::vector<WallSegment> walls;
+
+  /**
+   * @brief Makes the four perimeter walls of a square field centered on the
+   * origin
+   *
+   * @param width Distance between the inside faces of opposite walls. A
+   * standard 12 ft field is about 140.4 in inside.
+   * @return FieldWalls
+   */
+  static FieldWalls perimeter(QLength width = 140.4_in);
+};
+}  // namespace rev
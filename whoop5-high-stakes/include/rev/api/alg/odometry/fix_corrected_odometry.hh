@@ -0,0 +1,135 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "odometry.hh"
+#include "rev/api/async/async_runner.hh"
+#include "rev/api/async/seqlock.hh"
+
+namespace rev {
+
+/**
+ * @brief Tuning for FixCorrectedOdometry and FusedOdometry
+ *
+ * Noise is given as standard deviations. The defaults suit tracking wheels and
+ * a V5 GPS reading the field strips from a few feet away.
+ */
+struct FusionConfig {
+  // Position error the tracking wheels gain per meter travelled
+  double translation_noise{0.02};
+  // Heading error the inertial gains per radian turned
+  double rotation_noise{0.01};
+  // Error of the heading the GPS reports
+  QAngle gps_heading_error{2_deg};
+  // Fixes reporting more error than this are ignored outright
+  QLength max_gps_error{10_cm};
+  // Fixes further than this from the estimate, in standard deviations of the
+  // innovation, are rejected as outliers
+  double outlier_gate{3.5};
+  // After this many outliers in a row, the estimate is taken to be wrong
+  // instead, such as after a collision, and is reset to the next fix. Zero
+  // disables this.
+  uint32_t reseed_after{25};
+};
+
+/**
+ * @brief Odometry which corrects another odometry with position fixes, fed
+ * with the fixes
+ *
+ * The inner odometry is dead reckoned between fixes, and an extended Kalman
+ * filter blends in each fix weighted by the error reported for it. This reads
+ * no sensors, so it also runs under OFF_ROBOT_TESTS against a simulated GPS.
+ * FusedOdometry feeds it from a V5 GPS.
+ *
+ * The inner odometry must be stepped separately, before each update.
+ */
+class FixCorrectedOdometry : public Odometry {
+ public:
+  /**
+   * @brief Construct a new Fix Corrected Odometry
+   *
+   * @param iodometry Odometry to dead reckon with
+   * @param iconfig
+   */
+  FixCorrectedOdometry(std::shared_ptr<Odometry> iodometry,
+                       FusionConfig iconfig = FusionConfig());
+
+  /**
+   * @brief Get the current position
+   *
+   * Like the inner odometry, this is thread-safe and never blocks
+   *
+   * @return OdometryState
+   */
+  OdometryState get_state() override;
+
+  /**
+   * @brief Set the position, in the field frame
+   *
+   * The estimate is trusted fully until the robot moves or a fix arrives
+   *
+   * @param pos
+   */
+  void set_position(Position pos) override;
+  void reset_position() override;
+
+  /**
+   * @brief Applies the inner odometry's motion since the last update
+   *
+   */
+  void update();
+
+  /**
+   * @brief Applies the inner odometry's motion since the last update, then
+   * fuses a fix
+   *
+   * Each fix must only be given once, since fusing it again would overweight
+   * it
+   *
+   * @param fix Where the robot is, in the field frame
+   * @param error Standard deviation of the fix's position. Fixes with more
+   * error than the config's max_gps_error are ignored.
+   */
+  void update(Pose fix, QLength error);
+
+  /**
+   * @brief Get the number of fixes which have been rejected as outliers
+   *
+   * @return uint32_t
+   */
+  uint32_t get_rejected_fixes();
+
+  /**
+   * @brief Get the number of times the estimate was reset to a fix after too
+   * many outliers in a row
+   *
+   * @return uint32_t
+   */
+  uint32_t get_reseeds();
+
+ private:
+  std::shared_ptr<Odometry> odometry;
+  FusionConfig config;
+
+  // Serializes updates and set_position(). Readers never take this.
+  rmutex estimate_mutex;
+  Pose estimate{{0_in, 0_in}, 0_deg};
+  // Covariance of estimate's x and y in meters and theta in radians
+  double covariance[3][3]{};
+  // Copy of the estimate which get_state() reads from
+  Seqlock<OdometryState> published_state{
+      OdometryState{{{0_in, 0_in}, 0_deg}, {0_mps, 0_mps, 0_deg / second}}};
+
+  // Inner odometry pose at the last update
+  Pose odometry_last{{0_in, 0_in}, 0_deg};
+  bool seeded{false};
+  uint32_t rejected_in_row{0};
+  std::atomic<uint32_t> rejected_total{0};
+  std::atomic<uint32_t> reseeds{0};
+
+  OdometryState predict();
+  void correct(Pose fix, QLength error);
+  void publish(const OdometryState& state);
+};
+}  // namespace rev
@@ -0,0 +1,45 @@
+#pragma once
+#include <memory>
+
+#include "fix_corrected_odometry.hh"
+#include "pros/gps.hpp"
+#include "rev/api/async/async_runnable.hh"
+
+namespace rev {
+
+/**
+ * @brief Odometry which corrects another odometry with GPS fixes
+ *
+ * Each new GPS fix is fused as described in FixCorrectedOdometry. Positions
+ * are in the GPS field frame, with its axes swapped to match the rest of rev:
+ * x is GPS y, y is GPS x, and headings increase clockwise from GPS north.
+ *
+ * The inner odometry must be stepped separately, before this.
+ */
+class FusedOdometry : public FixCorrectedOdometry, public AsyncRunnable {
+ public:
+  /**
+   * @brief Construct a new Fused Odometry
+   *
+   * @param iodometry Odometry to dead reckon with, such as a
+   * TwoRotationInertialOdometry
+   * @param igps A GPS with its offset from the center of rotation already set
+   * @param iconfig
+   */
+  FusedOdometry(std::shared_ptr<Odometry> iodometry,
+                pros::Gps igps,
+                FusionConfig iconfig = FusionConfig());
+
+  /**
+   * @brief Applies the inner odometry's motion, then any new GPS fix
+   *
+   */
+  void step() override;
+
+ private:
+  pros::Gps gps;
+
+  // The last fix seen, so that a fix is only fused once
+  pros::c::gps_status_s_t fix_last{};
+};
+}  // namespace rev
@@ -0,0 +1,128 @@
+#pragma once
+#include <cstdint>
+
+#include "odometry_sample.hh"
+
+namespace rev {
+
+/**
+ * @brief Settings for a HeadingFusion
+ *
+ */
+struct HeadingFusionConfig {
+  // Multiplies the rotation each inertial reports, to correct its scale
+  // error. Measure it as the true rotation over the reported rotation across
+  // several whole turns.
+  double scales[MAX_INERTIALS]{1, 1, 1, 1};
+  // Heading random walk of each inertial once its bias is removed, in degrees
+  // per square root second
+  double drift_noise{0.02};
+  // Uncertainty left in each scale, as a fraction of the rotation
+  double scale_noise{0.002};
+  // Whether to learn the biases while the robot is stationary
+  bool estimate_bias{true};
+  // How long the tracking wheels must be still before the robot counts as
+  // stationary
+  QTime stationary_time{0.25_s};
+  // Fastest the fused heading may turn, after bias correction, for the robot
+  // to count as stationary
+  QAngularSpeed stationary_rate{1 * degree / second};
+  // Time constant of the bias estimates. Longer is steadier, but needs longer
+  // stops to converge.
+  QTime bias_time_constant{2_s};
+};
+
+/**
+ * @brief Fuses the headings of several inertials into one
+ *
+ * Each inertial's rotation is scaled by its scale factor, has its bias
+ * subtracted, and the results are averaged. While the tracking wheels are
+ * still and the inertials agree the robot isn't turning, the heading is held
+ * and whatever rotation the inertials report is taken as their bias. This is
+ * a zero-velocity update, and it is what keeps slow drift out of long runs.
+ *
+ * Readings of PROS_ERR_F are left out of the average, and a sensor which
+ * comes back is picked up again from its next reading.
+ *
+ * This reads no sensors, so it runs on a host for replaying logs.
+ */
+class HeadingFusion {
+ public:
+  /**
+   * @brief Starts fusing from a sample
+   *
+   * The fused heading starts at the first inertial's heading. Learned biases
+   * are kept.
+   *
+   * @param sample
+   */
+  void reset(const OdometrySample& sample);
+
+  /**
+   * @brief Adds the headings from a sample
+   *
+   * Call reset() with the first sample
+   *
+   * @param sample
+   * @param wheels_still True if the tracking wheels haven't moved since the
+   * last sample
+   * @return double The fused heading in degrees. This is unwrapped, so it
+   * keeps counting past a full turn.
+   */
+  double update(const OdometrySample& sample, bool wheels_still);
+
+  /**
+   * @brief Returns the fused heading in degrees, as of the last update
+   *
+   */
+  double get_heading() const;
+
+  /**
+   * @brief Returns the variance of the fused heading in square degrees
+   *
+   * This grows as the robot turns and with time while it moves, and is held
+   * while it is stationary
+   */
+  double get_variance() const;
+
+  /**
+   * @brief Zeroes the heading variance, for when the heading is known
+   *
+   */
+  void clear_variance();
+
+  /**
+   * @brief Returns the learned bias of one inertial, in degrees per second
+   *
+   * @param i
+   */
+  double get_bias(size_t i) const;
+
+  /**
+   * @brief Returns true if the robot was stationary at the last update
+   *
+   */
+  bool is_stationary() const;
+
+  explicit HeadingFusion(const HeadingFusionConfig& iconfig = {});
+
+ private:
+  HeadingFusionConfig config;
+
+  // The last good reading from each inertial, and when it changed
+  double raw_last[MAX_INERTIALS]{};
+  uint64_t changed_time[MAX_INERTIALS]{};
+  bool has_reading[MAX_INERTIALS]{};
+  double bias[MAX_INERTIALS]{};  // In degrees per second, after scaling
+
+  double heading{0};
+  double variance{0};
+  uint64_t time_last{0};
+
+  // Start of the current stop of the wheels, in micros
+  uint64_t still_since{0};
+  // Low-passed fused turn rate, in degrees per second
+  double rate{0};
+  bool stationary{false};
+};
+}  // namespace rev
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+
+#include "rev/api/units/all_units.hh"
+
+namespace rev {
+
+/**
+ * @brief Why an odometry sensor stopped being trusted
+ *
+ */
+enum class SensorFault : uint8_t {
+  NONE,        // Healthy
+  ERROR_CODE,  // PROS reported an error reading it, such as it being unplugged
+  STALE,       // Its reading stopped changing while the robot kept moving
+  JUMP         // Its reading moved much further than the drive did
+};
+
+/**
+ * @brief Which odometry sensors are trusted
+ *
+ * A sensor faulted for an error code or for going stale is trusted again as
+ * soon as it reports again, so a cable knocked loose for a moment doesn't
+ * cost it for the rest of the match. One which jumped stays faulted until the
+ * faults are cleared, since its later readings can't be told from good ones.
+ */
+struct OdometryHealth {
+  SensorFault longitudinal{SensorFault::NONE};
+  SensorFault lateral{SensorFault::NONE};
+  // Set once every inertial has failed. One failing of several is left out
+  // of the fused heading without faulting.
+  SensorFault inertial{SensorFault::NONE};
+  // The drive motor encoders. Without them faults are only found from error
+  // codes, and nothing can be substituted.
+  SensorFault drive{SensorFault::NONE};
+
+  /**
+   * @brief Returns true if any tracking sensor is faulted, so the position
+   * is coming at least partly from the drive encoders
+   *
+   */
+  bool is_degraded() const {
+    return longitudinal != SensorFault::NONE ||
+           lateral != SensorFault::NONE || inertial != SensorFault::NONE;
+  }
+};
+
+/**
+ * @brief Drive geometry and fault thresholds for falling back to the drive
+ * motor encoders
+ *
+ * With a skid-steer drive the encoders give the forward travel and the turn,
+ * though the turn is only as good as the track width, and wheel slip makes
+ * both worse than the tracking sensors. There is no sideways travel.
+ */
+struct DriveFallbackConfig {
+  QLength wheel_diameter;  // Diameter of the drive wheels
+  double gear_ratio;       // Drive wheel turns per motor turn
+  // Distance between the left and right wheels. Scrub usually makes the
+  // effective width a little wider than measured.
+  QLength track_width;
+
+  // A tracking wheel which doesn't change while the drive model says it
+  // should have rolled this far is stale. The distance only counts while
+  // another tracking sensor shows the robot moving, so wheels spinning in
+  // place while pushing or pinned don't add to it. The drive can still slip
+  // while the robot turns against something, hence the margin.
+  QLength stale_distance{48_in};
+  // Likewise for the inertials not changing while the drive turns and a
+  // tracking wheel rolls
+  QAngle stale_turn{45_deg};
+  // A tracking wheel which disagrees with the drive by this much in one
+  // sample has jumped
+  QLength jump_distance{2_in};
+  // Likewise for the inertials
+  QAngle jump_turn{20_deg};
+};
+}  // namespace rev
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "rev/api/units/q_angle.hh"
+#include "rev/api/units/q_length.hh"
+#include "rev/util/math/point_vector.hh"
+
+namespace rev {
+
+/**
+ * @brief Methods of turning one step of wheel travel into a displacement
+ *
+ */
+enum class OdometryIntegrator {
+  EULER,       // Straight line along the heading at the start of the step
+  MIDPOINT,    // Straight line along the average heading over the step
+  EXPONENTIAL  // Exact arc of constant curvature, i.e. the SE(2) exponential
+               // map. This is the most accurate and the default.
+};
+
+/**
+ * @brief Wheel and heading travel measured over one odometry step
+ *
+ */
+struct OdometryDelta {
+  QLength longitudinal;  // Distance rolled by the longitudinal wheel
+  QLength lateral;       // Distance rolled by the lateral wheel
+  QAngle heading_delta;  // Change in heading, in [-180deg, 180deg)
+  QAngle heading;        // Heading at the end of the step
+};
+
+/**
+ * @brief Computes how far the tracking center moved in the field frame over
+ * one step
+ *
+ * Headings follow the inertial sensor, increasing clockwise.
+ *
+ * @param integrator The integration method to use
+ * @param delta The travel measured over the step
+ * @param longitudinal_offset Offset of the longitudinal wheel to the right of
+ * the center of rotation
+ * @param lateral_offset Offset of the lateral wheel backward from the center
+ * of rotation
+ * @return PointVector The displacement in the field frame
+ */
+PointVector integrate_odometry(OdometryIntegrator integrator,
+                               const OdometryDelta& delta,
+                               QLength longitudinal_offset,
+                               QLength lateral_offset);
+}  // namespace rev
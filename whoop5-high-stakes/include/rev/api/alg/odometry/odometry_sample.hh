@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "odometry.hh"
+#include "pros/error.h"
+
+namespace rev {
+
+/**
+ * @brief Most inertials a sample can carry
+ *
+ */
+constexpr size_t MAX_INERTIALS = 4;
+
+/**
+ * @brief One raw reading of the odometry sensors
+ *
+ * These are the sensor values exactly as PROS reports them, so that a log of
+ * samples can be replayed through odometry with different settings. A robot
+ * with one inertial leaves the extra headings empty, and one without drive
+ * encoders leaves them at PROS_ERR_F.
+ */
+struct OdometrySample {
+  uint64_t time;         // Time the reading was taken, in micros
+  int32_t longitudinal;  // Longitudinal rotation sensor, in centidegrees
+  int32_t lateral;       // Lateral rotation sensor, in centidegrees
+  double heading;        // First inertial heading, in degrees
+  // Number of inertials after the first one
+  uint8_t extra_inertials{0};
+  // Headings of the inertials after the first one, in degrees
+  double extra_headings[MAX_INERTIALS - 1]{};
+  // Average position of the left and right drive motors, in degrees
+  double left_drive{PROS_ERR_F};
+  double right_drive{PROS_ERR_F};
+
+  /**
+   * @brief Returns how many inertials were read
+   *
+   */
+  size_t inertial_count() const { return 1 + extra_inertials; }
+
+  /**
+   * @brief Returns the heading of one of the inertials
+   *
+   * @param i Below inertial_count()
+   */
+  double inertial_heading(size_t i) const {
+    return i == 0 ? heading : extra_headings[i - 1];
+  }
+};
+
+/**
+ * @brief Odometry which is driven by OdometrySamples rather than by reading
+ * sensors itself
+ *
+ */
+class SampledOdometry : public Odometry {
+ public:
+  /**
+   * @brief Integrates one sensor reading
+   *
+   * Readings identical to the previous one are treated as the sensors not
+   * having refreshed yet
+   *
+   * @param sample
+   */
+  virtual void add_sample(const OdometrySample& sample) = 0;
+};
+}  // namespace rev
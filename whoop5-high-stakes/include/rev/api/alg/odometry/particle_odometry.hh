@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+
+#include "range_corrected_odometry.hh"
+#include "pros/distance.hpp"
+#include "rev/api/async/async_runnable.hh"
+
+namespace rev {
+
+/**
+ * @brief A distance sensor and where it is on the robot
+ *
+ */
+struct DistanceSensorMount {
+  pros::Distance sensor;
+  // Position of the sensor relative to the center of rotation, with x forward
+  // and y to the right, and the direction it faces
+  Pose offset;
+};
+
+/**
+ * @brief Odometry which corrects another odometry by ranging field walls with
+ * V5 distance sensors
+ *
+ * Each reading is fused as described in RangeCorrectedOdometry. Readings
+ * below the config's min_confidence are skipped.
+ *
+ * The inner odometry must be stepped separately, before this.
+ */
+class ParticleOdometry : public RangeCorrectedOdometry, public AsyncRunnable {
+ public:
+  /**
+   * @brief Construct a new Particle Odometry
+   *
+   * The particles start around the inner odometry's position, which should
+   * already be set in the field frame
+   *
+   * @param iodometry Odometry to move the particles with
+   * @param ifield Walls the distance sensors can see
+   * @param isensors
+   * @param iconfig
+   */
+  ParticleOdometry(std::shared_ptr<Odometry> iodometry,
+                   FieldWalls ifield,
+                   std::vector<DistanceSensorMount> isensors,
+                   ParticleConfig iconfig = ParticleConfig());
+
+  /**
+   * @brief Moves the particles, then weights them against the distance
+   * sensors if an update is due
+   *
+   */
+  void step() override;
+
+ private:
+  std::vector<DistanceSensorMount> sensors;
+  int32_t min_confidence;
+  // Ranges read this step, kept so step() never allocates
+  std::vector<QLength> readings;
+};
+}  // namespace rev
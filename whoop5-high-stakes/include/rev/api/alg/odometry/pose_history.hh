@@ -0,0 +1,213 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "odometry.hh"
+
+namespace rev {
+
+/**
+ * @brief Fixed-size record of recent odometry states, indexed by time
+ *
+ * Late sensor readings can be matched to where the robot was when they were
+ * sampled, rather than where it is when they arrive. Times are in the
+ * microseconds of get_clock(). Once full, each new state overwrites the
+ * oldest, so nothing is ever allocated.
+ *
+ * This is a ring with one writer and any number of readers, and neither
+ * ever waits on the other. Like a Seqlock, each entry carries a sequence
+ * number which the writer makes odd while it fills the entry, and a reader
+ * which copied an entry mid-write, or one the writer has since lapped, throws
+ * the copy away and searches again. Only one thread may call record() and
+ * clear() at a time.
+ *
+ * @tparam N The number of states kept, which must be a power of two
+ */
+template <size_t N>
+class PoseHistory {
+  static_assert(N > 1 && (N & (N - 1)) == 0,
+                "PoseHistory capacity must be a power of two");
+
+ public:
+  PoseHistory() {
+    for (Slot& slot : slots)
+      slot.sequence.store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Adds the state at a time. Times must not go backwards.
+   *
+   * This is wait-free, but must not be called from two threads at once
+   *
+   * @param time
+   * @param state
+   */
+  void record(uint64_t time, const OdometryState& state) {
+    uint32_t begin = first.load(std::memory_order_relaxed);
+    uint32_t end = head.load(std::memory_order_relaxed);
+
+    // A later state for the same time replaces the earlier one. Only this
+    // thread writes, so its own entries can be read without checking.
+    if (end != begin) {
+      Entry newest = load_words(slots[(end - 1) & (N - 1)]);
+      if (newest.time >= time) {
+        store(end - 1, {end - 1, time, state});
+        return;
+      }
+    }
+
+    store(end, {end, time, state});
+    head.store(end + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Forgets every state, as when the position is set
+   *
+   * Like record(), this must not be called from two threads at once
+   */
+  void clear() {
+    first.store(head.load(std::memory_order_relaxed),
+                std::memory_order_release);
+  }
+
+  /**
+   * @brief Gets the state at a time, interpolating between the recorded
+   * states either side of it
+   *
+   * This is a binary search, so it takes O(log N). It never blocks the writer.
+   *
+   * @param time
+   * @param state Set to the state at that time. Times after the newest state
+   * get the newest state.
+   * @return true if the time is covered, false if it is older than everything
+   * kept or nothing has been recorded
+   */
+  bool state_at(uint64_t time, OdometryState& state) const {
+    Entry before, after;
+    while (true) {
+      // first is only ever moved up to a value head already had, so reading
+      // it before head keeps it at or below head
+      uint32_t begin = first.load(std::memory_order_acquire);
+      uint32_t end = head.load(std::memory_order_acquire);
+      if (end - begin > N)
+        begin = end - N;
+      if (end == begin)
+        return false;
+
+      if (!load(begin, before) || !load(end - 1, after))
+        continue;
+      if (time < before.time)
+        return false;
+      if (time >= after.time) {
+        state = after.state;
+        return true;
+      }
+
+      // Find the first state after the time. The oldest is not after it, and
+      // the newest is.
+      uint32_t low = begin;
+      uint32_t high = end - 1;
+      bool torn = false;
+      while (high - low > 1 && !torn) {
+        uint32_t middle = low + (high - low) / 2;
+        Entry entry;
+        torn = !load(middle, entry);
+        if (torn)
+          break;
+        if (entry.time > time) {
+          high = middle;
+          after = entry;
+        } else {
+          low = middle;
+          before = entry;
+        }
+      }
+      if (!torn)
+        break;
+    }
+
+    double fraction =
+        double(time - before.time) / double(after.time - before.time);
+    state.pos = interpolate(before.state.pos, after.state.pos, fraction);
+    const Velocity& v0 = before.state.vel;
+    const Velocity& v1 = after.state.vel;
+    state.vel.xv = v0.xv + (v1.xv - v0.xv) * fraction;
+    state.vel.yv = v0.yv + (v1.yv - v0.yv) * fraction;
+    state.vel.angular = v0.angular + (v1.angular - v0.angular) * fraction;
+    return true;
+  }
+
+  /**
+   * @brief Get the number of states kept
+   *
+   * @return size_t
+   */
+  size_t size() const {
+    uint32_t begin = first.load(std::memory_order_acquire);
+    uint32_t end = head.load(std::memory_order_acquire);
+    return end - begin > N ? N : end - begin;
+  }
+
+  static constexpr size_t capacity() { return N; }
+
+ private:
+  struct Entry {
+    uint32_t index;  // Which record this is, to tell it from older laps
+    uint64_t time;
+    OdometryState state;
+  };
+
+  static constexpr size_t WORDS =
+      (sizeof(Entry) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+  // An entry stored as relaxed atomic words, as in Seqlock, so that copying
+  // one mid-write is well defined and only the sequence check rejects it
+  struct Slot {
+    std::atomic<uint32_t> sequence;  // Odd while being written
+    std::atomic<uint32_t> words[WORDS];
+  };
+
+  void store(uint32_t index, const Entry& entry) {
+    Slot& slot = slots[index & (N - 1)];
+    uint32_t s = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint32_t words[WORDS] = {};
+    std::memcpy(words, &entry, sizeof(Entry));
+    for (size_t i = 0; i < WORDS; i++)
+      slot.words[i].store(words[i], std::memory_order_relaxed);
+
+    slot.sequence.store(s + 2, std::memory_order_release);
+  }
+
+  // Copies the entry of a record, returning false if it was being written or
+  // has been overwritten by a later record
+  bool load(uint32_t index, Entry& entry) const {
+    const Slot& slot = slots[index & (N - 1)];
+    uint32_t before = slot.sequence.load(std::memory_order_acquire);
+    entry = load_words(slot);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint32_t after = slot.sequence.load(std::memory_order_relaxed);
+    return (before & 1) == 0 && before == after && entry.index == index;
+  }
+
+  static Entry load_words(const Slot& slot) {
+    uint32_t words[WORDS];
+    for (size_t i = 0; i < WORDS; i++)
+      words[i] = slot.words[i].load(std::memory_order_relaxed);
+
+    Entry entry;
+    std::memcpy(&entry, words, sizeof(Entry));
+    return entry;
+  }
+
+  Slot slots[N];
+  // Records ever written, and the first which hasn't been cleared. Both only
+  // count up, wrapping after 2^32 records, which is over a year of samples.
+  std::atomic<uint32_t> head{0};
+  std::atomic<uint32_t> first{0};
+};
+}  // namespace rev
@@ -0,0 +1,167 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "field_walls.hh"
+#include "odometry.hh"
+#include "rev/api/async/async_runner.hh"
+#include "rev/api/async/seqlock.hh"
+
+namespace rev {
+
+/**
+ * @brief Tuning for RangeCorrectedOdometry and ParticleOdometry
+ *
+ * The cost of a step is proportional to particles times distance sensors
+ * times walls. On the V5 brain's Cortex-A9, 300 particles with two sensors
+ * against the perimeter stay well within a 10 ms tick. Raise update_period
+ * before lowering the particle count if the budget gets tight.
+ */
+struct ParticleConfig {
+  // Number of pose hypotheses. More particles recover from larger errors, but
+  // cost proportionally more time.
+  size_t particles{300};
+  // Steps between distance sensor updates. Motion is still applied every
+  // step. The sensors only refresh about every 30 ms anyway.
+  uint32_t update_period{3};
+  // Error the odometry gains, as a fraction of each step of travel
+  double translation_noise{0.05};
+  // Error the odometry heading gains, as a fraction of each step of turn
+  double rotation_noise{0.02};
+  // Spread of the particles around a position that is set
+  QLength initial_spread{2_in};
+  QAngle initial_heading_spread{2_deg};
+  // Readings beyond this or below this confidence, out of 63, are ignored
+  QLength max_range{2_m};
+  int32_t min_confidence{32};
+  // Chance that a reading is of something other than a wall, such as a game
+  // element or another robot
+  double outlier_probability{0.1};
+  // The particles are resampled once the effective number of them falls below
+  // this fraction of the total
+  double resample_threshold{0.5};
+  uint32_t seed{0x2545F491};
+};
+
+/**
+ * @brief Odometry which corrects another odometry by ranging field walls, fed
+ * with the ranges
+ *
+ * This is Monte Carlo localization. Each particle is moved by the inner
+ * odometry's motion plus noise, then weighted by how well the distances it
+ * predicts to the walls match the measured ranges. Positions are in the frame
+ * of the FieldWalls, with rev's usual axes. This reads no sensors, so it also
+ * runs under OFF_ROBOT_TESTS. ParticleOdometry feeds it from V5 distance
+ * sensors.
+ *
+ * Particles are stored as arrays of floats, one per coordinate, so the
+ * per-particle loops can be vectorized. All of the storage is allocated on
+ * construction, and update() never allocates.
+ *
+ * The inner odometry must be stepped separately, before each update.
+ */
+class RangeCorrectedOdometry : public Odometry {
+ public:
+  /**
+   * @brief Construct a new Range Corrected Odometry
+   *
+   * The particles start around the inner odometry's position, which should
+   * already be set in the field frame
+   *
+   * @param iodometry Odometry to move the particles with
+   * @param ifield Walls the distance sensors can see
+   * @param isensor_offsets Position of each distance sensor relative to the
+   * center of rotation, with x forward and y to the right, and the direction
+   * it faces
+   * @param iconfig
+   */
+  RangeCorrectedOdometry(std::shared_ptr<Odometry> iodometry,
+                         FieldWalls ifield,
+                         std::vector<Pose> isensor_offsets,
+                         ParticleConfig iconfig = ParticleConfig());
+
+  /**
+   * @brief Get the weighted mean of the particles
+   *
+   * This is thread-safe and never blocks
+   *
+   * @return OdometryState
+   */
+  OdometryState get_state() override;
+
+  /**
+   * @brief Scatters the particles around a position in the field frame
+   *
+   * @param pos
+   */
+  void set_position(Position pos) override;
+  void reset_position() override;
+
+  /**
+   * @brief Returns true if the next update() is due to weigh the particles
+   * against ranges
+   *
+   * The sensors only need to be read when this is true
+   */
+  bool is_update_due();
+
+  /**
+   * @brief Moves the particles by the inner odometry's motion, then weights
+   * them against the ranges if an update is due
+   *
+   * @param ranges One range per sensor, in the order the offsets were given,
+   * or nullptr if the sensors were not read. Ranges of zero or less, or beyond
+   * the config's max_range, are skipped.
+   */
+  void update(const QLength* ranges);
+
+ private:
+  std::shared_ptr<Odometry> odometry;
+  FieldWalls field;
+  std::vector<Pose> sensor_offsets;
+  ParticleConfig config;
+
+  // Serializes updates and set_position(). Readers never take this.
+  rmutex particles_mutex;
+  Seqlock<OdometryState> published_state{
+      OdometryState{{0_in, 0_in, 0_deg}, {0_mps, 0_mps, 0_deg / second}}};
+
+  // Particles, in meters and radians
+  std::vector<float> xs;
+  std::vector<float> ys;
+  std::vector<float> thetas;
+  std::vector<float> weights;
+  // Per-particle scratch for the sensor update and resampling
+  std::vector<float> cos_thetas;
+  std::vector<float> sin_thetas;
+  std::vector<float> ray_xs;
+  std::vector<float> ray_ys;
+  std::vector<float> ray_dxs;
+  std::vector<float> ray_dys;
+  std::vector<float> ranges;
+  std::vector<float> resampled_xs;
+  std::vector<float> resampled_ys;
+  std::vector<float> resampled_thetas;
+
+  Pose odometry_last{0_in, 0_in, 0_deg};
+  Pose estimate{0_in, 0_in, 0_deg};
+  uint32_t steps_since_update{0};
+  // Sensor updates wait for motion, or repeated resampling of the same
+  // readings would collapse the particles
+  bool moved_since_update{false};
+  uint32_t rng_state;
+
+  float uniform();
+  float gaussian();
+  void scatter(Pose pos);
+  // Moves the particles by a motion in the robot frame, with noise
+  void predict(Pose motion);
+  // Weights the particles against one distance reading
+  void weigh(Pose offset, QLength range);
+  void update_trig();
+  void normalize_and_resample();
+  void update_estimate();
+};
+}  // namespace rev
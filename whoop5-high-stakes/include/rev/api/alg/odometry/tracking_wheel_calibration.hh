@@ -0,0 +1,118 @@
+#pragma once
+#include <cstddef>
+
+#include "odometry_sample.hh"
+
+namespace rev {
+
+/**
+ * @brief The kinds of motion a calibration is recorded from
+ *
+ */
+enum class CalibrationMotion {
+  SPIN,      // Turning in place, any number of turns
+  FORWARD,   // A straight line along the robot's forward direction
+  SIDEWAYS   // A straight line to the robot's right, such as pushed by hand
+};
+
+/**
+ * @brief Tracking wheel geometry fitted by a TrackingWheelCalibrator
+ *
+ * These are the values TwoRotationInertialOdometry is constructed with
+ */
+struct WheelCalibration {
+  QLength longitudinal_wheel_diameter;
+  QLength lateral_wheel_diameter;
+  QLength longitudinal_wheel_offset;
+  QLength lateral_wheel_offset;
+  // Root mean square of the travel each fit fails to explain per segment
+  QLength longitudinal_residual;
+  QLength lateral_residual;
+  // False if there were no sideways segments, in which case the lateral
+  // wheel is assumed to be the same size as the longitudinal one
+  bool lateral_diameter_fitted;
+};
+
+/**
+ * @brief Fits the tracking wheel diameters and offsets to recorded motions
+ *
+ * Record some spins in both directions, and some straight lines of known
+ * length. During a spin each wheel only rolls by its offset times the turn,
+ * and along a line it rolls the length of the line, so
+ *
+ *   (pi * diameter / 360) * wheel_degrees + offset * turn_radians = travel
+ *
+ * is linear in the wheel's size and offset, and is solved by least squares
+ * over every segment. Only a few sums are kept per wheel, so any number of
+ * segments can be added without allocating.
+ *
+ * The samples are the same ones odometry integrates, so this runs on the
+ * robot or on a host against a log from OdometryLogWriter.
+ */
+class TrackingWheelCalibrator {
+ public:
+  /**
+   * @brief Starts recording a segment
+   *
+   * The robot should be still when this is called
+   *
+   * @param imotion
+   * @param idistance How far the robot is moved, in the direction of the
+   * motion. Ignored for spins.
+   */
+  void begin_segment(CalibrationMotion imotion, QLength idistance = 0_in);
+
+  /**
+   * @brief Adds a sample to the current segment
+   *
+   * Samples outside of a segment are ignored
+   *
+   * @param sample
+   */
+  void add_sample(const OdometrySample& sample);
+
+  /**
+   * @brief Finishes the current segment, once the robot has come to a stop
+   *
+   */
+  void end_segment();
+
+  /**
+   * @brief Forgets every segment
+   *
+   */
+  void reset();
+
+  /**
+   * @brief Solves for the wheel geometry
+   *
+   * @param result Set to the fitted geometry
+   * @return true if there was enough data, which is at least one spin and
+   * one forward line
+   */
+  bool solve(WheelCalibration& result);
+
+ private:
+  // Sums for the normal equations of one wheel, where a is the wheel travel
+  // in degrees, b is the turn in radians and y is the known travel in meters
+  struct WheelSums {
+    double aa{0}, ab{0}, bb{0}, ay{0}, by{0}, yy{0};
+    size_t segments{0};
+    size_t lines{0};
+
+    void add(double a, double b, double y, bool line);
+  };
+
+  WheelSums longitudinal;
+  WheelSums lateral;
+
+  // The segment being recorded
+  bool recording{false};
+  CalibrationMotion motion{CalibrationMotion::SPIN};
+  QLength distance{0_in};
+  bool has_sample{false};
+  OdometrySample first{0, 0, 0, 0.0};
+  OdometrySample last{0, 0, 0, 0.0};
+  double turn{0};  // Unwrapped turn so far, in degrees
+};
+}  // namespace rev
@@ -0,0 +1,213 @@
+#pragma once
+#include <memory>
+
+#include "heading_fusion.hh"
+#include "odometry_health.hh"
+#include "odometry_integrator.hh"
+#include "odometry_sample.hh"
+#include "pose_history.hh"
+#include "velocity_estimator.hh"
+#include "rev/api/async/async_runner.hh"
+#include "rev/api/async/seqlock.hh"
+namespace rev {
+/**
+ * @brief Odometry from 2 tracking wheels and an inertial, fed with samples
+ *
+ * This does all of the integration but reads no sensors, so it also runs
+ * under OFF_ROBOT_TESTS to replay logged samples.
+ * TwoRotationInertialOdometry feeds it from the real sensors.
+ *
+ * Each sensor is checked every sample. With a drive fallback set, the drive
+ * encoders are used to catch sensors which freeze or jump, and stand in for
+ * any which have faulted. Each faulted sensor is swapped out on the sample
+ * its fault is found, before that sample's travel is used, so the position
+ * carries on without a step.
+ */
+class TrackingWheelOdometry : public SampledOdometry {
+ public:
+  /**
+   * @brief Get the current position
+   *
+   * The implementation of this is thread-safe, and never blocks or waits on
+   * the odometry thread
+   *
+   * @return OdometryState
+   */
+  OdometryState get_state() override;
+  void set_position(Position pos) override;
+  void reset_position() override;
+
+  /**
+   * @brief Integrates one sensor reading
+   *
+   * The V5 sensors only publish new readings every few milliseconds, so
+   * samples can be added faster than that. Each new reading is stamped with
+   * the time of the first sample it was seen in, and velocities are measured
+   * between readings rather than between samples.
+   *
+   * @param sample
+   */
+  void add_sample(const OdometrySample& sample) override;
+
+  /**
+   * @brief Sets how each step of wheel travel is integrated into the position
+   *
+   * @param iintegrator Defaults to OdometryIntegrator::EXPONENTIAL
+   */
+  void set_integrator(OdometryIntegrator iintegrator);
+
+  /**
+   * @brief Sets how velocities are estimated from each new sample
+   *
+   * Each velocity component gets its own copy of the prototype, so filter
+   * state is never shared between them. The estimators are reset whenever the
+   * robot goes stationary or the position is set.
+   *
+   * @param prototype Defaults to RawVelocity, which differences the latest
+   * sample only
+   */
+  void set_velocity_estimator(const VelocityEstimator& prototype);
+
+  /**
+   * @brief Sets how the inertials are fused into one heading
+   *
+   * Call this before the first sample. Biases learned so far are forgotten.
+   *
+   * @param iconfig
+   */
+  void set_heading_fusion(const HeadingFusionConfig& iconfig);
+
+  /**
+   * @brief Gets the variance of the heading since it was last set
+   *
+   * Like get_state(), this never blocks
+   *
+   * @return double In square degrees
+   */
+  double get_heading_variance();
+
+  /**
+   * @brief Sets up the drive encoders as a check on, and fallback for, the
+   * tracking sensors
+   *
+   * Samples must then carry the drive positions
+   *
+   * @param iconfig
+   */
+  void set_drive_fallback(const DriveFallbackConfig& iconfig);
+
+  /**
+   * @brief Gets which sensors are trusted
+   *
+   * Like get_state(), this never blocks
+   *
+   * @return OdometryHealth
+   */
+  OdometryHealth get_health();
+
+  /**
+   * @brief Trusts every sensor again
+   *
+   * Sensors which went stale or reported an error code are trusted again on
+   * their own once they report again. Call this once a sensor which jumped is
+   * known to be working, such as after reseating it while disabled. The
+   * position is kept.
+   */
+  void clear_faults();
+
+  /**
+   * @brief Gets where the robot was at a recent time
+   *
+   * Use this to match a late sensor reading to the pose it was taken from.
+   * About the last HISTORY_SIZE sensor samples are kept, and setting the
+   * position forgets them. It never blocks odometry from updating.
+   *
+   * @param time In the microseconds of get_clock()
+   * @param state Set to the interpolated state at that time
+   * @return true if the time is still in the history
+   */
+  bool state_at(uint64_t time, OdometryState& state);
+
+  static constexpr size_t HISTORY_SIZE = 128;
+
+  TrackingWheelOdometry(QLength ilongitudinal_wheel_diameter = 3.25 * inch,
+                        QLength ilateral_wheel_diameter = 3.25 * inch,
+                        QLength ilongitudinal_wheel_offset = 0 * inch,
+                        QLength ilateral_wheel_offset = 0 * inch);
+
+ private:
+  // Serializes add_sample() and set_position(). Readers never take this.
+  rmutex current_position_mutex;
+  OdometryState current_position{{0_in, 0_in, 0_deg},
+                                 {0_mps, 0_mps, 0_deg / second}};
+  // Copy of current_position which get_state() reads from
+  Seqlock<OdometryState> published_state{current_position};
+  // Copy of the heading variance which get_heading_variance() reads from
+  Seqlock<double> published_heading_variance{0.0};
+  // Copy of health which get_health() reads from
+  Seqlock<OdometryHealth> published_health;
+  // Published states by sample time. current_position_mutex keeps it to the
+  // one writer it allows.
+  PoseHistory<HISTORY_SIZE> history;
+
+  // Used for getting differences
+  double longitude_ticks_last{0};
+  double latitude_ticks_last{0};
+  // Combines the inertials into the heading the ticks below are in
+  HeadingFusion heading_fusion;
+  // The fused heading as of the last sample
+  double fused_heading_last{0};
+  // Only used for velocity calculation
+  double heading_ticks_last{0};
+  // We call this init instead of last because it is used for absolutes
+  double heading_ticks_init{0};
+  // Time the last new sample was seen, in micros
+  uint64_t sample_time_last{0};
+
+  bool is_initialized {false};
+
+  // Sensor checks against the drive encoders
+  OdometryHealth health;
+  DriveFallbackConfig drive_fallback{3.25_in, 1, 12_in};
+  bool has_drive_fallback{false};
+  double left_drive_last{0};
+  double right_drive_last{0};
+  // How far each sensor should have moved since it last changed
+  QLength longitudinal_unseen{0_in};
+  QLength lateral_unseen{0_in};
+  double heading_unseen{0};  // In degrees
+  // The inertial readings of the last sample, to tell whether they changed
+  double inertial_headings_last[MAX_INERTIALS]{};
+
+  // Faults a wheel whose travel is implausible against the drive's, or
+  // trusts a stale one again once it changes. It only counts as unseen while
+  // another sensor shows the robot moving.
+  void check_wheel(SensorFault& wheel,
+                   QLength travel,
+                   QLength predicted,
+                   bool others_moved,
+                   QLength& unseen);
+  // Records the first fault of a sensor
+  static void fault(SensorFault& sensor, SensorFault reason);
+
+  // Wheel sizes
+  QLength longitudinal_wheel_diameter;
+  QLength lateral_wheel_diameter;
+
+  OdometryIntegrator integrator{OdometryIntegrator::EXPONENTIAL};
+
+  // One estimator per velocity component
+  std::unique_ptr<VelocityEstimator> xv_estimator{
+      std::make_unique<RawVelocity>()};
+  std::unique_ptr<VelocityEstimator> yv_estimator{
+      std::make_unique<RawVelocity>()};
+  std::unique_ptr<VelocityEstimator> angular_estimator{
+      std::make_unique<RawVelocity>()};
+  void reset_velocity_estimators();
+
+  // Offset of the longitudinal wheel to the right of the center of the robot
+  QLength longitudinal_wheel_offset;
+  // Likewise, for the lateral wheel backward from the center of rotation
+  QLength lateral_wheel_offset;
+};
+};  // namespace rev
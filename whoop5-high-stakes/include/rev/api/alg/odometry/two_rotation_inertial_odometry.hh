@@ -1,28 +1,82 @@
 #pragma once
-#include "odometry.hh"
+#include <memory>
+#include <vector>
+
+#include "tracking_wheel_odometry.hh"
 #include "pros/imu.hpp"
+#include "pros/motors.hpp"
 #include "pros/rotation.hpp"
-#include "pros/rtos.hpp"
 #include "rev/api/async/async_runnable.hh"
+#include "rev/api/telemetry/odometry_log.hh"
 namespace rev {
 /**
- * @brief Odometry implementation using 2 tracking wheels and an inertial
+ * @brief Odometry implementation using 2 tracking wheels and one or more
+ * inertials
  *
+ * With several inertials, their headings are fused as set by
+ * set_heading_fusion(). Give it the drive motors with set_drive_encoders() to
+ * keep going when a sensor fails.
  */
-class TwoRotationInertialOdometry : public Odometry, public AsyncRunnable {
+class TwoRotationInertialOdometry : public TrackingWheelOdometry,
+                                    public AsyncRunnable {
  public:
   /**
-   * @brief Get the current position
-   *
-   * The implementation of this is thread-safe
+   * @brief Reads the sensors and integrates any new sample
    *
-   * @return OdometryState
+   * The V5 sensors only publish new readings every few milliseconds, so this
+   * can be stepped faster than that. Each new sample is stamped with the time
+   * it was first seen, and velocities are measured between samples rather
+   * than between calls, so a late wakeup doesn't skew them.
    */
-  OdometryState get_state() override;
-  void set_position(Position pos) override;
-  void reset_position() override;
   void step() override;
 
+  /**
+   * @brief Reads the sensors without integrating them
+   *
+   * This is the sample step() would add, for feeding a
+   * TrackingWheelCalibrator or anything else which wants raw readings
+   *
+   * @return OdometrySample
+   */
+  OdometrySample read_sample();
+
+  /**
+   * @brief Sets how often the sensors refresh their readings
+   *
+   * @param rate The refresh interval in milliseconds. The sensors round this
+   * down to a multiple of 5, with a minimum of 5.
+   */
+  void set_data_rate(uint32_t rate);
+
+  /**
+   * @brief Reads the drive motors to check the tracking sensors against, and
+   * to fall back on if they fail
+   *
+   * This sets the motors' encoder units to degrees. Call it before odometry
+   * is started.
+   *
+   * @param ileft The left drive motors, moving the robot forward when
+   * positive
+   * @param iright The right drive motors, likewise
+   * @param iconfig The drive geometry and fault thresholds
+   */
+  void set_drive_encoders(pros::MotorGroup& ileft,
+                          pros::MotorGroup& iright,
+                          const DriveFallbackConfig& iconfig);
+
+  /**
+   * @brief Captures the raw sensor readings into a ring, to be written to a
+   * log by an OdometryLogWriter and replayed later
+   *
+   * Capturing never blocks. Repeated readings are only captured every 10 ms,
+   * which is enough for a replay to see when the robot stops. Call this
+   * before odometry is started.
+   *
+   * @param iring The ring to capture into, or nullptr to stop capturing. This
+   * odometry must be its only producer.
+   */
+  void set_capture(std::shared_ptr<OdometryLogRing> iring);
+
   TwoRotationInertialOdometry(pros::Rotation ilongitudinal_sensor,
                               pros::Rotation ilateral_sensor,
                               pros::Imu iinertial,
@@ -32,6 +86,21 @@ class TwoRotationInertialOdometry : public Odometry, public AsyncRunnable {
                               QLength ilongitudinal_wheel_offset = 0 * inch,
                               QLength ilateral_wheel_offset = 0 * inch);
 
+  /**
+   * @brief Construct odometry reading several inertials
+   *
+   * @param iinertials Between 1 and MAX_INERTIALS inertials. Any more are
+   * ignored.
+   */
+  TwoRotationInertialOdometry(pros::Rotation ilongitudinal_sensor,
+                              pros::Rotation ilateral_sensor,
+                              std::vector<pros::Imu> iinertials,
+                              QLength ilongitudinal_wheel_diameter = 3.25 *
+                                                                     inch,
+                              QLength ilateral_wheel_diameter = 3.25 * inch,
+                              QLength ilongitudinal_wheel_offset = 0 * inch,
+                              QLength ilateral_wheel_offset = 0 * inch);
+
  private:
   pros::Rotation longitudinal_sensor;  // Sensor indicating forward motion.
                                        // Moving the robot forward should cause
@@ -39,31 +108,18 @@ class TwoRotationInertialOdometry : public Odometry, public AsyncRunnable {
   pros::Rotation lateral_sensor;       // Sensor indicating motion to the right.
                                   // Moving the robot right should cause the
                                   // position of this to increase.
-  pros::Imu inertial;  // Inertial sensor from which the robot yaw will be read
-
-  pros::Mutex current_position_mutex;
-  OdometryState current_position{{0_in, 0_in, 0_deg},
-                                 {0_mps, 0_mps, 0_deg / second}};
-
-  // Used for getting differences
-  double longitude_ticks_last;
-  double latitude_ticks_last;
-  // Only used for velocity calculation
-  double heading_ticks_last;
-  // We call this init instead of last because it is used for absolutes
-  double heading_ticks_init;
-  // Time of last call
-  int32_t time_last{-1};
-
-  bool is_initialized {false};
+  // Inertial sensors from which the robot yaw will be read
+  std::vector<pros::Imu> inertials;
+  // Drive motors, or nullptr without a drive fallback
+  pros::MotorGroup* left_drive{nullptr};
+  pros::MotorGroup* right_drive{nullptr};
+  // Set once an IMU has finished calibrating at startup
+  bool started{false};
 
-  // Wheel sizes
-  QLength longitudinal_wheel_diameter;
-  QLength lateral_wheel_diameter;
+  // Reads one IMU's heading, or PROS_ERR_F if it can't be used
+  double read_heading(size_t i);
 
-  // Offset of the longitudinal wheel to the right of the center of the robot
-  QLength longitudinal_wheel_offset;
-  // Likewise, for the lateral wheel backward from the center of rotation
-  QLength lateral_wheel_offset;
+  std::shared_ptr<OdometryLogRing> capture;
+  OdometrySample captured_last{0, 0, 0, 0.0};
 };
-};  // namespace rev
\ No newline at end of file
+};  // namespace rev
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace rev {
+
+/**
+ * @brief Interface for estimating a velocity from successive displacements
+ *
+ * Odometry keeps one estimator per velocity component and feeds it each new
+ * sensor sample. Implementations must not allocate in update(), since it runs
+ * at the odometry rate.
+ */
+class VelocityEstimator {
+ public:
+  virtual ~VelocityEstimator() = default;
+
+  /**
+   * @brief Adds a sample and gets the new estimate
+   *
+   * @param displacement Distance moved since the previous sample, in SI units
+   * @param dt Time since the previous sample, in seconds
+   * @return double The estimated velocity, in SI units per second
+   */
+  virtual double update(double displacement, double dt) = 0;
+
+  /**
+   * @brief Forgets all samples, as when the robot is known to be stationary
+   *
+   */
+  virtual void reset() = 0;
+
+  /**
+   * @brief Makes a fresh estimator with the same settings
+   *
+   * @return std::unique_ptr<VelocityEstimator>
+   */
+  virtual std::unique_ptr<VelocityEstimator> clone() const = 0;
+};
+
+/**
+ * @brief Unfiltered finite difference of the latest sample
+ *
+ * This has no lag, but passes through all of the sensor noise
+ */
+class RawVelocity : public VelocityEstimator {
+ public:
+  double update(double displacement, double dt) override;
+  void reset() override;
+  std::unique_ptr<VelocityEstimator> clone() const override;
+};
+
+/**
+ * @brief Exponential moving average of the finite differences
+ *
+ */
+class EmaVelocity : public VelocityEstimator {
+ public:
+  /**
+   * @brief Construct a new Ema Velocity estimator
+   *
+   * @param ialpha Weight of the newest sample, in (0.0, 1.0]. Smaller values
+   * filter more noise but lag more.
+   */
+  explicit EmaVelocity(double ialpha);
+
+  double update(double displacement, double dt) override;
+  void reset() override;
+  std::unique_ptr<VelocityEstimator> clone() const override;
+
+ private:
+  double alpha;
+  double velocity{0.0};
+  bool primed{false};
+};
+
+/**
+ * @brief Least squares slope of position over the last few samples
+ *
+ * The lag is about half the window. Up to MAX_WINDOW samples are kept in a
+ * fixed buffer.
+ */
+class LeastSquaresVelocity : public VelocityEstimator {
+ public:
+  static constexpr size_t MAX_WINDOW = 16;
+
+  /**
+   * @brief Construct a new Least Squares Velocity estimator
+   *
+   * @param iwindow Number of samples to fit, from 2 to MAX_WINDOW
+   */
+  explicit LeastSquaresVelocity(size_t iwindow);
+
+  double update(double displacement, double dt) override;
+  void reset() override;
+  std::unique_ptr<VelocityEstimator> clone() const override;
+
+ private:
+  size_t window;
+  double positions[MAX_WINDOW];
+  double times[MAX_WINDOW];
+  size_t count{0};  // Samples in the buffer
+  size_t next{0};   // Index the next sample is written to
+  double position{0.0};
+  double time{0.0};
+};
+
+/**
+ * @brief Kalman filter tracking position and velocity under a constant
+ * velocity model
+ *
+ */
+class KalmanVelocity : public VelocityEstimator {
+ public:
+  /**
+   * @brief Construct a new Kalman Velocity estimator
+   *
+   * @param iprocess_noise Spectral density of the unmodeled acceleration, in
+   * SI units squared per second cubed. Larger values track changes faster.
+   * @param imeasurement_noise Variance of each position measurement, in SI
+   * units squared
+   */
+  KalmanVelocity(double iprocess_noise, double imeasurement_noise);
+
+  double update(double displacement, double dt) override;
+  void reset() override;
+  std::unique_ptr<VelocityEstimator> clone() const override;
+
+ private:
+  double process_noise;
+  double measurement_noise;
+
+  // State, relative to the latest measured position
+  double position{0.0};
+  double velocity{0.0};
+  // Covariance
+  double p00{1.0}, p01{0.0}, p11{1.0};
+};
+}  // namespace rev
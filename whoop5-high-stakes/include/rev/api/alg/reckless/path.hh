@@ -1,49 +1,204 @@
 #pragma once
 
+#include <functional>
 #include <memory>
-#include <vector>
+#include <variant>
 
 #include "rev/api/alg/drive/correction/correction.hh"
+#include "rev/api/alg/drive/correction/no_correction.hh"
+#include "rev/api/alg/drive/correction/pilons_correction.hh"
+#include "rev/api/alg/drive/motion/cascading_motion.hh"
+#include "rev/api/alg/drive/motion/constant_motion.hh"
 #include "rev/api/alg/drive/motion/motion.hh"
+#include "rev/api/alg/drive/motion/profiled_motion.hh"
+#include "rev/api/alg/drive/motion/proportional_motion.hh"
+#include "rev/api/alg/drive/stop/simple_stop.hh"
 #include "rev/api/alg/drive/stop/stop.hh"
+#include "rev/util/static_vector.hh"
 
 namespace rev {
 
+/**
+ * @brief A motion strategy, held by value if it is one of the built-in ones
+ *
+ * Built-in strategies are stored in the segment itself and called directly.
+ * Any other Motion can still be used through a shared_ptr, and is called
+ * virtually.
+ */
+using MotionStrategy = std::variant<ConstantMotion,
+                                    ProportionalMotion,
+                                    CascadingMotion,
+                                    ProfiledMotion,
+                                    std::shared_ptr<Motion>>;
+
+/**
+ * @brief A correction strategy, held by value if it is one of the built-in
+ * ones
+ *
+ */
+using CorrectionStrategy =
+    std::variant<NoCorrection, PilonsCorrection, std::shared_ptr<Correction>>;
+
+/**
+ * @brief A stop strategy, held by value if it is one of the built-in ones
+ *
+ * A stop strategy keeps state while it runs. One held by value belongs to its
+ * segment, and starts fresh each time the path is driven. One held through a
+ * shared_ptr is shared by every segment and path it was given to.
+ */
+using StopStrategy = std::variant<SimpleStop, std::shared_ptr<Stop>>;
+
+/**
+ * @brief An action run when a segment reaches some progress
+ *
+ */
+struct ProgressTrigger {
+  // Fraction of the way along the segment, as by Reckless::progress without
+  // the segment's index
+  double progress;
+  std::function<void()> action;
+  bool fired{false};
+};
+
+/**
+ * @brief Most triggers a RecklessPathSegment can hold
+ *
+ */
+constexpr size_t MAX_SEGMENT_TRIGGERS = 4;
+
 /**
  * @brief Path segment for use with Reckless controller
  *
+ * Built-in strategies can be passed by value, which keeps the whole segment
+ * free of heap allocations:
+ *
+ * ```cpp
+ * RecklessPathSegment(ConstantMotion(0.5), PilonsCorrection(4, 0.3_in),
+ *                     SimpleStop(0.03_s, 0.15_s, 0.3), {20_in, 0_in, 0_deg})
+ * ```
+ *
+ * Passing std::make_shared of a strategy also still works.
+ *
+ * Actions can be attached to run part way along the segment:
+ *
+ * ```cpp
+ * RecklessPathSegment(...).with_trigger(0.6, [] { intake.move(127); })
+ * ```
  */
 struct RecklessPathSegment {
-  std::shared_ptr<Motion> motion;
-  std::shared_ptr<Correction> correction;
-  std::shared_ptr<Stop> stop;
+  MotionStrategy motion;
+  CorrectionStrategy correction;
+  StopStrategy stop;
 
   Position start_point;
   Position target_point;
   QLength drop_early;
 
-  RecklessPathSegment(std::shared_ptr<Motion> imotion,
-                      std::shared_ptr<Correction> icorrection,
-                      std::shared_ptr<Stop> istop,
+  StaticVector<ProgressTrigger, MAX_SEGMENT_TRIGGERS> triggers;
+
+  RecklessPathSegment(MotionStrategy imotion,
+                      CorrectionStrategy icorrection,
+                      StopStrategy istop,
                       Position itarget_point,
                       QLength idrop_early = 0 * inch)
-      : motion(imotion),
-        correction(icorrection),
-        stop(istop),
+      : motion(std::move(imotion)),
+        correction(std::move(icorrection)),
+        stop(std::move(istop)),
         target_point(itarget_point),
         drop_early(idrop_early) {
     start_point = {0_in, 0_in, 0_deg};
   }
+
+  /**
+   * @brief Runs an action once the segment reaches some progress
+   *
+   * The action runs on the control thread, on the step the progress is first
+   * reached, so it must not block. Actions which haven't run by the time the
+   * segment ends run then, so each runs exactly once per time the path is
+   * driven, unless the motion is broken out of. An action may call go() or
+   * breakout() on the Reckless driving it, which ends the step it runs in.
+   * Throws std::length_error if the segment already has MAX_SEGMENT_TRIGGERS.
+   *
+   * @param iprogress Fraction of the way along the segment, from 0 to 1
+   * @param iaction
+   * @return RecklessPathSegment&
+   */
+  RecklessPathSegment& with_trigger(double iprogress,
+                                    std::function<void()> iaction);
+
+  /**
+   * @brief Generates powers with this segment's motion strategy
+   *
+   * @param frame
+   * @return std::tuple<double, double>
+   */
+  std::tuple<double, double> gen_powers(const SegmentFrame& frame);
+
+  /**
+   * @brief Corrects powers with this segment's correction strategy
+   *
+   * @param frame
+   * @param powers
+   * @return std::tuple<double, double>
+   */
+  std::tuple<double, double> apply_correction(
+      const SegmentFrame& frame,
+      std::tuple<double, double> powers);
+
+  /**
+   * @brief Finds the stop state with this segment's stop strategy
+   *
+   * @param frame
+   * @return stop_state
+   */
+  stop_state get_stop_state(const SegmentFrame& frame);
+
+  /**
+   * @brief Gets the coast power of this segment's stop strategy
+   *
+   * @return double
+   */
+  double get_coast_power();
 };
 
+/**
+ * @brief Most segments a RecklessPath can hold
+ *
+ * A segment is a few hundred bytes, so a whole path is several kilobytes. Split
+ * long routines into several paths rather than raising this, since paths are
+ * often built on a task's stack.
+ */
+constexpr size_t MAX_PATH_SEGMENTS = 32;
+
 /**
  * @brief Complete path for use with the Reckless Controller
  *
  */
 struct RecklessPath {
-  std::vector<RecklessPathSegment> segments;
+  // Held inline, so building a path never allocates. Adding more than
+  // MAX_PATH_SEGMENTS throws std::length_error.
+  StaticVector<RecklessPathSegment, MAX_PATH_SEGMENTS> segments;
+  // How far before its drop point each segment starts handing over to the
+  // next. 0 stops at the end of every segment.
+  QLength blend_distance{0_in};
 
-  RecklessPath() { segments = std::vector<RecklessPathSegment>(); }
   RecklessPath& with_segment(RecklessPathSegment segment);
+
+  /**
+   * @brief Runs the segments together as one continuous motion
+   *
+   * Over the last stretch of each segment the powers shift from its motion
+   * to the next segment's, and the correction aims at a point sliding from
+   * its target to the next one. A segment then hands over to the next as soon
+   * as it reaches its drop point, without coasting or braking. Only the last
+   * segment stops.
+   *
+   * Segments which run the opposite way to the one before them, such as
+   * backing up after driving forward, still stop first.
+   *
+   * @param iblend_distance How far before each drop point to start blending
+   * @return RecklessPath&
+   */
+  RecklessPath& with_blending(QLength iblend_distance);
 };
 }  // namespace rev
\ No newline at end of file
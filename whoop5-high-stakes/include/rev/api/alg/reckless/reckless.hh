@@ -4,8 +4,10 @@
 
 #include "rev/api/alg/reckless/path.hh"
 #include "rev/api/async/async_awaitable.hh"
+#include "rev/api/async/event.hh"
 #include "rev/api/async/async_runnable.hh"
 #include "rev/api/hardware/chassis/chassis.hh"
+#include "rev/api/telemetry/telemetry.hh"
 
 namespace rev {
 
@@ -28,13 +30,24 @@ class Reckless : public AsyncRunnable, public AsyncAwaitable {
   /**
    * @brief Blocks until the motion is completed
    *
+   * This wakes on the same tick the motion completes, rather than polling.
    */
   void await() override;
 
+  /**
+   * @brief Blocks until the motion is completed or the timeout expires
+   *
+   * @param timeout The longest time to wait
+   * @return true if the motion completed
+   */
+  bool await_for(QTime timeout) override;
+
   /**
    * This function starts the robot along a path
+   *
+   * The path is copied, so the same path can be driven again
    */
-  void go(RecklessPath path);
+  void go(const RecklessPath& path);
 
   /**
    * This function returns the current status of the controller
@@ -58,14 +71,73 @@ class Reckless : public AsyncRunnable, public AsyncAwaitable {
    */
   void breakout();
 
+  /**
+   * @brief Records a TelemetryRecord into the ring on every step of a motion
+   *
+   * Recording never blocks. If the ring is full, the record is dropped and
+   * counted as an overflow. Call this while no motion is running.
+   *
+   * @param iring The ring to record into, or nullptr to stop recording. This
+   * controller must be its only producer.
+   */
+  void set_telemetry(std::shared_ptr<TelemetryRing> iring);
+
  private:
   std::shared_ptr<Chassis> chassis;
   std::shared_ptr<Odometry> odometry;
   RecklessPath current_path;
   RecklessStatus status{RecklessStatus::DONE};
+  Event done;  // Set whenever status is DONE
+  stop_state last_stop_state{stop_state::GO};
+  std::shared_ptr<TelemetryRing> telemetry;
 
   size_t current_segment{0};
   long long brake_time = -1;
   double partial_progress{-1.0};
+  // Counts go() and breakout() calls, so step() can tell when a trigger's
+  // action has ended or replaced the path under it
+  uint32_t paths_started{0};
+
+  // The current segment's geometry, measured against the robot each step
+  SegmentFrame frame;
+  // While blending, the next segment's geometry from where the robot is
+  SegmentFrame next_frame;
+  // While blending, the line from the robot to the point being aimed at
+  SegmentFrame blend_frame;
+
+  /**
+   * @brief Makes the current segment start from a position, if there is one
+   *
+   * @param start
+   */
+  void start_segment(const Position& start);
+
+  /**
+   * @brief Ends the current segment and starts the next from a position
+   *
+   * @param pos
+   * @return false if a trigger's action called go() or breakout(), in which
+   * case the path is no longer this one and the step must stop
+   */
+  bool next_segment(const Position& pos);
+
+  /**
+   * @brief Runs the current segment's triggers which have been reached and
+   * haven't run yet
+   *
+   * @param segment_progress Progress along the current segment alone
+   * @return false if an action called go() or breakout(), in which case the
+   * path is no longer this one and the step must stop
+   */
+  bool fire_triggers(double segment_progress);
+
+  /**
+   * @brief Measures the next segment from the robot, if the path blends
+   * into it
+   *
+   * @param state
+   * @return true if the current segment should blend into the next
+   */
+  bool update_next_frame(const OdometryState& state);
 };
 }  // namespace rev
@@ -0,0 +1,44 @@
+#pragma once
+
+namespace rev {
+
+/**
+ * @brief Whether an action is still running
+ *
+ */
+enum class ActionStatus { RUNNING, DONE };
+
+/**
+ * @brief Interface for one step of an autonomous routine
+ *
+ * Actions are driven by a Sequencer. start() is called once when the action
+ * begins, then update() is called on every tick until it returns DONE. Both
+ * are called from the scheduler thread, so they must never block.
+ */
+class Action {
+ public:
+  virtual ~Action() = default;
+
+  /**
+   * @brief Begins the action
+   *
+   */
+  virtual void start() = 0;
+
+  /**
+   * @brief Advances the action by one tick
+   *
+   * @return ActionStatus DONE once the action has finished
+   */
+  virtual ActionStatus update() = 0;
+
+  /**
+   * @brief Ends the action early
+   *
+   * This is called instead of any further updates when a race is won by
+   * another action or the routine is cancelled. It is only called on actions
+   * which have been started and are not yet done.
+   */
+  virtual void cancel() {}
+};
+}  // namespace rev
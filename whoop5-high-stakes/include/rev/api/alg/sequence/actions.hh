@@ -0,0 +1,128 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "rev/api/alg/drive/turn/campbell_turn.hh"
+#include "rev/api/alg/reckless/reckless.hh"
+#include "rev/api/alg/sequence/action.hh"
+#include "rev/api/alg/trajectory/ramsete_follower.hh"
+
+namespace rev {
+
+/**
+ * @brief Drives a path, finishing when Reckless completes it
+ *
+ * @param reckless
+ * @param path
+ * @return std::shared_ptr<Action>
+ */
+std::shared_ptr<Action> drive_path(std::shared_ptr<Reckless> reckless,
+                                   const RecklessPath& path);
+
+/**
+ * @brief Turns to an absolute heading, finishing when the turn completes
+ *
+ * @param turn
+ * @param max_power The maximum power the controller will output
+ * @param angle The absolute heading to turn to
+ * @return std::shared_ptr<Action>
+ */
+std::shared_ptr<Action> turn_to(std::shared_ptr<CampbellTurn> turn,
+                                double max_power,
+                                QAngle angle);
+
+/**
+ * @brief Follows a trajectory, finishing when the follower completes it
+ *
+ * @param follower
+ * @param trajectory
+ * @return std::shared_ptr<Action>
+ */
+std::shared_ptr<Action> follow_trajectory(
+    std::shared_ptr<RamseteFollower> follower,
+    std::vector<squiggles::ProfilePoint> trajectory);
+
+/**
+ * @brief Waits until Reckless has made the given progress along its path
+ *
+ * Progress is measured as by Reckless::progress, so 1.5 is halfway through
+ * the second segment. This also finishes if the motion completes first.
+ *
+ * @param reckless
+ * @param progress
+ * @return std::shared_ptr<Action>
+ */
+std::shared_ptr<Action> wait_until_progress(std::shared_ptr<Reckless> reckless,
+                                            double progress);
+
+/**
+ * @brief Waits for a fixed amount of time
+ *
+ * @param duration
+ * @return std::shared_ptr<Action>
+ */
+std::shared_ptr<Action> wait_time(QTime duration);
+
+/**
+ * @brief Waits until a condition becomes true
+ *
+ * @param condition Checked once per tick
+ * @return std::shared_ptr<Action>
+ */
+std::shared_ptr<Action> wait_until(std::function<bool()> condition);
+
+/**
+ * @brief Runs a function once and finishes immediately
+ *
+ * Use this for instantaneous actions, such as actuating a piston
+ *
+ * @param function
+ * @return std::shared_ptr<Action>
+ */
+std::shared_ptr<Action> run(std::function<void()> function);
+
+/**
+ * @brief Runs something until a condition becomes true
+ *
+ * For example, running the intake until the beam break is tripped
+ *
+ * @param begin Called when the action starts
+ * @param condition Checked once per tick
+ * @param end Called when the condition becomes true, or if the action is
+ * cancelled
+ * @return std::shared_ptr<Action>
+ */
+std::shared_ptr<Action> run_until(std::function<void()> begin,
+                                  std::function<bool()> condition,
+                                  std::function<void()> end);
+
+/**
+ * @brief Runs actions one after another
+ *
+ * When an action finishes, the next one is started on the same tick
+ *
+ * @param actions
+ * @return std::shared_ptr<Action>
+ */
+std::shared_ptr<Action> sequence(std::vector<std::shared_ptr<Action>> actions);
+
+/**
+ * @brief Runs actions at the same time, finishing once all of them have
+ *
+ * @param actions
+ * @return std::shared_ptr<Action>
+ */
+std::shared_ptr<Action> parallel(std::vector<std::shared_ptr<Action>> actions);
+
+/**
+ * @brief Runs actions at the same time, finishing as soon as any of them has
+ *
+ * The actions which have not finished are cancelled
+ *
+ * @param actions
+ * @return std::shared_ptr<Action>
+ */
+std::shared_ptr<Action> race(std::vector<std::shared_ptr<Action>> actions);
+}  // namespace rev
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <memory>
+
+#include "rev/api/alg/sequence/action.hh"
+#include "rev/api/async/async_awaitable.hh"
+#include "rev/api/async/async_runnable.hh"
+#include "rev/api/async/async_runner.hh"
+#include "rev/api/async/event.hh"
+
+namespace rev {
+
+/**
+ * @brief Runs an autonomous routine built from Actions
+ *
+ * Add this to the same Scheduler as the controllers it drives, with
+ * SEQUENCER_ORDER, so that a motion started by an action is stepped by its
+ * controller on the same tick. The whole routine then advances without any
+ * dead time between actions.
+ */
+class Sequencer : public AsyncRunnable, public AsyncAwaitable {
+ public:
+  Sequencer();
+
+  /**
+   * @brief Starts a routine, cancelling the current one if there is one
+   *
+   * The routine is started on the next step
+   *
+   * @param iroutine
+   */
+  void run(std::shared_ptr<Action> iroutine);
+
+  /**
+   * @brief Cancels the current routine
+   *
+   */
+  void cancel();
+
+  /**
+   * @brief Tells whether the routine has finished or been cancelled
+   *
+   * @return true if nothing is running
+   */
+  bool is_completed();
+
+  /**
+   * @brief Advances the current routine by one tick
+   *
+   */
+  void step() override;
+
+  /**
+   * @brief Blocks until the routine finishes or is cancelled
+   *
+   */
+  void await() override;
+
+  /**
+   * @brief Blocks until the routine finishes or is cancelled, or the timeout
+   * expires
+   *
+   * @param timeout The longest time to wait
+   * @return true if the routine finished or was cancelled
+   */
+  bool await_for(QTime timeout) override;
+
+ private:
+  rmutex mutex;
+  std::shared_ptr<Action> routine;
+  bool started{false};
+  Event done;  // Set whenever routine is null
+};
+}  // namespace rev
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "okapi/squiggles/geometry/profilepoint.hpp"
+#include "rev/api/alg/odometry/odometry.hh"
+#include "rev/api/async/async_awaitable.hh"
+#include "rev/api/async/async_runnable.hh"
+#include "rev/api/async/event.hh"
+#include "rev/api/hardware/chassis/chassis.hh"
+#include "rev/api/units/all_units.hh"
+
+namespace rev {
+
+/**
+ * @brief Gains and drive model for a RamseteFollower
+ *
+ */
+struct RamseteConfig {
+  // Distance between the left and right wheels
+  QLength track_width;
+  // Wheel speed at full power
+  QSpeed max_speed;
+
+  // How hard position error is corrected, in rad^2/m^2. Larger converges
+  // faster but overshoots more.
+  double b{2.0};
+  // Damping, between 0 and 1
+  double zeta{0.7};
+
+  // Extra power per in/s^2 of wheel acceleration
+  double k_a{0.0};
+  // Power needed to get the wheels moving, added in the direction they turn
+  double k_s{0.0};
+};
+
+/**
+ * @brief Follows a time-parameterized trajectory from squiggles, closing the
+ * loop on odometry with a RAMSETE controller
+ *
+ * At each step the trajectory is sampled at the time since following began.
+ * The robot's position error from that sample, in the robot's frame, is
+ * turned into corrections to the sample's linear and angular velocity, and
+ * those are turned into wheel speeds and then into powers with a feedforward
+ * model.
+ *
+ * Generate the trajectory in rev's field frame, passing x and y in meters and
+ * the heading in radians to squiggles as they are. Squiggles takes that frame
+ * to be a mirror image of its own, which leaves the geometry alone but swaps
+ * which wheel_velocities entry is which, so only the pose, velocity and
+ * curvature of each point are used. Points with negative velocities are
+ * driven in reverse.
+ *
+ * The follower finishes when the trajectory's time runs out.
+ */
+class RamseteFollower : public AsyncRunnable, public AsyncAwaitable {
+ public:
+  RamseteFollower(std::shared_ptr<Chassis> ichassis,
+                  std::shared_ptr<Odometry> iodometry,
+                  RamseteConfig iconfig);
+
+  /**
+   * @brief Starts following a trajectory from the first step after this
+   *
+   * @param trajectory Points in order of time, starting at time 0
+   */
+  void follow(const std::vector<squiggles::ProfilePoint>& trajectory);
+
+  /**
+   * @brief Steps the controller, for use with AsyncRunner.
+   *
+   */
+  void step() override;
+
+  /**
+   * @brief Blocks until the trajectory is finished
+   *
+   */
+  void await() override;
+
+  /**
+   * @brief Blocks until the trajectory is finished or the timeout expires
+   *
+   * @param timeout The longest time to wait
+   * @return true if the trajectory finished
+   */
+  bool await_for(QTime timeout) override;
+
+  /**
+   * @brief Tells if the controller is working or has completed its motion
+   *
+   * @return true if the controller is not doing anything
+   */
+  bool is_completed();
+
+  /**
+   * @brief Ends the trajectory immediately and stops the chassis
+   *
+   */
+  void breakout();
+
+  /**
+   * @brief Gets the fraction of the trajectory's time which has passed, or
+   * -1.0 if the controller is not running
+   *
+   */
+  double progress();
+
+ private:
+  // One point of the trajectory, in rev's units
+  struct Sample {
+    QTime time;
+    Position pos;
+    QSpeed v;
+    QAcceleration a;
+    double curvature;  // Per meter, positive turning clockwise
+  };
+
+  /**
+   * @brief Interpolates the trajectory at a time, moving cursor forward to
+   * the segment containing it
+   *
+   * @param time
+   */
+  Sample sample(QTime time);
+
+  std::shared_ptr<Chassis> chassis;
+  std::shared_ptr<Odometry> odometry;
+  RamseteConfig config;
+
+  std::vector<Sample> trajectory;
+  size_t cursor{0};
+  // Time following began, in millis, or -1 if it starts on the next step
+  long long start_time{-1};
+  double partial_progress{-1.0};
+  bool active{false};
+  Event done;  // Set whenever not active
+};
+}  // namespace rev
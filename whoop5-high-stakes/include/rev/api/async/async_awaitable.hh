@@ -1,5 +1,7 @@
 #pragma once
 
+#include "rev/api/units/q_time.hh"
+
 namespace rev {
 /**
  * @brief Interface for classes which have something that can be waited for
@@ -12,6 +14,16 @@ class AsyncAwaitable {
    *
    */
   virtual void await() = 0;
+
+  /**
+   * @brief Blocking method which returns when the awaited event has occured or
+   * the timeout expires, whichever comes first
+   *
+   * @param timeout The longest time to wait
+   * @return true if the awaited event occured
+   * @return false if the timeout expired first
+   */
+  virtual bool await_for(QTime timeout) = 0;
 };
 
 }  // namespace rev
\ No newline at end of file
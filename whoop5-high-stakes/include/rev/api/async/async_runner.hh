@@ -1,33 +1,129 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #ifndef OFF_ROBOT_TESTS
 #include "pros/apix.h"
 typedef pros::Task rthread;
+typedef pros::Mutex rmutex;
 #else
+#include <mutex>
 #include <thread>
 #include "pros/rtos.hpp"
 typedef std::thread rthread;
+typedef std::mutex rmutex;
 #endif
 #include "rev/api/async/async_runnable.hh"
+#include "rev/api/async/runner_config.hh"
+#include "rev/api/async/runner_stats.hh"
 namespace rev {
 /**
  * @brief Thread runner for AsyncRunnable
  *
+ * Steps are scheduled against absolute deadlines, so the time spent inside
+ * step() does not stretch the period. If a step overruns its deadline, the
+ * schedule is re-anchored to the current time instead of running the missed
+ * steps back to back.
+ *
+ * The thread is started on construction, and can be paused, resumed, stopped
+ * and started again without constructing a new runner. All of these are
+ * idempotent and may be called from any thread.
  */
 class AsyncRunner {
  public:
   AsyncRunner(std::shared_ptr<AsyncRunnable> icontroller,
               uint32_t itdelta = 10);
 
+  /**
+   * @brief Construct a new AsyncRunner with the given thread settings
+   *
+   * @param icontroller The runnable to step
+   * @param itdelta Time between steps in milliseconds
+   * @param iconfig Priority, stack depth and step budget
+   */
+  AsyncRunner(std::shared_ptr<AsyncRunnable> icontroller,
+              uint32_t itdelta,
+              RunnerConfig iconfig);
+
   ~AsyncRunner();
 
+  /**
+   * @brief Starts the thread if it is not already running
+   *
+   */
+  void start();
+
+  /**
+   * @brief Stops stepping the controller without stopping the thread
+   *
+   * Once this returns, the controller is not being stepped and will not be
+   * stepped again until resume() is called. Called from inside the
+   * controller's own step(), it lets that step finish and takes effect from
+   * the next one.
+   */
+  void pause();
+
+  /**
+   * @brief Resumes stepping the controller after pause()
+   *
+   * The schedule restarts from the current time, so the steps missed while
+   * paused are not counted as missed deadlines
+   */
+  void resume();
+
+  /**
+   * @brief Stops the thread and waits for it to exit
+   *
+   * start() may be called afterward to run the controller again
+   */
+  void stop_and_join();
+
+  /**
+   * @brief Tells whether the thread is running
+   *
+   * @return true if started and not stopped
+   */
+  bool is_running();
+
+  /**
+   * @brief Tells whether the runner is paused
+   *
+   * @return true if paused
+   */
+  bool is_paused();
+
+  /**
+   * @brief Gets the timing statistics of this runner
+   *
+   * @return RunnerStats
+   */
+  RunnerStats get_stats();
+
+  /**
+   * @brief Clears the timing statistics of this runner
+   *
+   */
+  void reset_stats();
+
  private:
   std::shared_ptr<AsyncRunnable> controller;
-  rthread* thread;
+  rthread* thread{nullptr};
   uint32_t tdelta;  // Time to wait between iterations in millis
+  RunnerConfig config;
+  uint64_t budget_us;  // config.budget in micros, or 0 if unchecked
+
+  std::atomic<bool> active{false};
+  std::atomic<bool> paused{false};
+
+  // Serializes start() and stop_and_join()
+  rmutex lifecycle_mutex;
+  // Held for the duration of each step, so pause() can wait one out
+  rmutex step_mutex;
+  // The thread running loop(), so pause() can tell it is called from a step
+  std::atomic<const void*> loop_thread{nullptr};
 
-  bool active{true};
+  RunnerStatsRecorder stats;
+  rmutex stats_mutex;
 
   // Helper function to launch thread
   static void run(void* context);
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "rev/api/units/q_time.hh"
+
+namespace rev {
+/**
+ * @brief Source of time for every rev component
+ *
+ * Controllers, stop conditions, simulators and odometry read the time through
+ * get_clock() instead of pros::millis, so that a simulation can swap in a
+ * VirtualClock and run faster than real time.
+ */
+class Clock {
+ public:
+  virtual ~Clock() = default;
+
+  /**
+   * @brief Gets the current time in milliseconds
+   *
+   * @return uint32_t
+   */
+  virtual uint32_t millis() = 0;
+
+  /**
+   * @brief Gets the current time in microseconds
+   *
+   * @return uint64_t
+   */
+  virtual uint64_t micros() = 0;
+
+  /**
+   * @brief Blocks the calling thread for the given number of milliseconds
+   *
+   * @param duration
+   */
+  virtual void delay(uint32_t duration) = 0;
+};
+
+/**
+ * @brief Clock backed by the RTOS, or by a steady clock under OFF_ROBOT_TESTS
+ *
+ */
+class SystemClock : public Clock {
+ public:
+  uint32_t millis() override;
+  uint64_t micros() override;
+  void delay(uint32_t duration) override;
+};
+
+/**
+ * @brief Clock which only moves when told to
+ *
+ * A simulation installs one with set_clock, then alternates advance() with
+ * stepping the simulator and controllers by hand, e.g.
+ *
+ *   while (!reckless->is_completed()) {
+ *     clock->advance(10_ms);
+ *     sim->step();
+ *     reckless->step();
+ *   }
+ *
+ * delay() advances the clock instead of sleeping, so code which waits on it
+ * returns immediately.
+ */
+class VirtualClock : public Clock {
+ public:
+  /**
+   * @brief Construct a new Virtual Clock
+   *
+   * @param start The time the clock starts at
+   */
+  explicit VirtualClock(QTime start = 0_s);
+
+  uint32_t millis() override;
+  uint64_t micros() override;
+  void delay(uint32_t duration) override;
+
+  /**
+   * @brief Moves the clock forward
+   *
+   * @param duration
+   */
+  void advance(QTime duration);
+
+ private:
+  std::atomic<uint64_t> now_us;
+};
+
+/**
+ * @brief Gets the clock used by rev components
+ *
+ * This is a SystemClock unless set_clock has been called. It is read several
+ * times per tick, so it hands out a reference rather than a shared_ptr, which
+ * would cost an atomic reference count update on every call.
+ *
+ * @return Clock&
+ */
+Clock& get_clock();
+
+/**
+ * @brief Replaces the clock used by rev components
+ *
+ * This should be called before any components are constructed or stepped,
+ * and not again until they have stopped, since the clock it replaces is
+ * destroyed if nothing else owns it. AsyncRunner and Scheduler always run on
+ * the system clock, since they schedule real threads.
+ *
+ * @param clock The new clock, or nullptr to go back to the system clock
+ */
+void set_clock(std::shared_ptr<Clock> clock);
+}  // namespace rev
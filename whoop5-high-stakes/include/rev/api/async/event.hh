@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+
+#include "rev/api/async/async_runner.hh"
+#include "rev/api/units/q_time.hh"
+#ifdef OFF_ROBOT_TESTS
+#include <condition_variable>
+#endif
+
+namespace rev {
+/**
+ * @brief A flag which threads can block on until it is set
+ *
+ * Setting the event wakes every waiting thread immediately. On the robot this
+ * is done with task notifications, so a task waiting on an Event should not
+ * use notify_take for anything else at the same time. Under OFF_ROBOT_TESTS
+ * it is a std::condition_variable.
+ */
+class Event {
+ public:
+  /**
+   * @brief Sets the event and wakes all waiting threads
+   *
+   */
+  void set();
+
+  /**
+   * @brief Clears the event, so that future waits will block
+   *
+   */
+  void clear();
+
+  /**
+   * @brief Tells whether the event is currently set
+   *
+   * @return true if the event is set
+   */
+  bool is_set();
+
+  /**
+   * @brief Blocks until the event is set
+   *
+   */
+  void wait();
+
+  /**
+   * @brief Blocks until the event is set or the timeout expires
+   *
+   * @param timeout The longest time to wait
+   * @return true if the event was set
+   * @return false if the timeout expired first
+   */
+  bool wait_for(QTime timeout);
+
+ private:
+  rmutex mutex;
+  bool flag{false};
+
+#ifndef OFF_ROBOT_TESTS
+  std::vector<pros::task_t> waiters;
+
+  void remove_waiter(pros::task_t task);
+#else
+  std::condition_variable condition;
+#endif
+};
+}  // namespace rev
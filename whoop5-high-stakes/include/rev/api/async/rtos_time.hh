@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+namespace rev {
+/**
+ * @brief Gets the number of milliseconds since the program started
+ *
+ * This reads pros::millis on the robot, and a steady clock under
+ * OFF_ROBOT_TESTS
+ *
+ * @return uint32_t
+ */
+uint32_t rtos_millis();
+
+/**
+ * @brief Gets the number of microseconds since the program started
+ *
+ * @return uint64_t
+ */
+uint64_t rtos_micros();
+
+/**
+ * @brief Blocks the calling thread for the given number of milliseconds
+ *
+ * @param duration
+ */
+void rtos_delay(uint32_t duration);
+
+/**
+ * @brief Gets a value which identifies the calling thread
+ *
+ * Two calls return the same value exactly when they are made from the same
+ * thread, while that thread is alive
+ *
+ * @return const void*
+ */
+const void* rtos_current_thread();
+
+/**
+ * @brief Tells whether a time read from rtos_millis has been reached
+ *
+ * This handles the millisecond counter wrapping around
+ *
+ * @param now The current time
+ * @param deadline The time being checked
+ * @return true if now is at or after deadline
+ */
+constexpr bool rtos_reached(uint32_t now, uint32_t deadline) {
+  return static_cast<int32_t>(now - deadline) >= 0;
+}
+}  // namespace rev
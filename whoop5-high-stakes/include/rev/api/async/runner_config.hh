@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "pros/rtos.h"
+#include "rev/api/async/async_runnable.hh"
+#include "rev/api/units/q_time.hh"
+
+namespace rev {
+
+/**
+ * @brief Called when a step takes longer than its budget
+ *
+ * The first argument is the runnable which overran, and the second is how
+ * long its step took
+ */
+typedef std::function<void(AsyncRunnable&, QTime)> BudgetCallback;
+
+/**
+ * @brief Settings for the thread behind an AsyncRunner or Scheduler
+ *
+ * Priority and stack depth are ignored under OFF_ROBOT_TESTS.
+ */
+struct RunnerConfig {
+  // Task priority, from 1 to TASK_PRIORITY_MAX. Higher priorities preempt
+  // lower ones, so anything other code depends on should sit above the
+  // default priority used by opcontrol.
+  uint32_t priority{TASK_PRIORITY_DEFAULT};
+  // Stack size in words
+  uint16_t stack_depth{TASK_STACK_DEPTH_DEFAULT};
+  // Longest a step is expected to take. Zero disables the check. For a
+  // Scheduler this is the budget for runnables added without their own.
+  QTime budget{0.0};
+  // Called from the runner thread whenever a step exceeds its budget. Budget
+  // overruns are also counted in RunnerStats whether or not this is set.
+  BudgetCallback on_budget_exceeded;
+};
+
+/**
+ * @brief Converts a step budget to microseconds for comparing against
+ * rtos_micros
+ *
+ * @param budget
+ * @return uint64_t The budget in microseconds, or 0 if it is disabled
+ */
+inline uint64_t budget_to_micros(QTime budget) {
+  if (budget <= 0_s)
+    return 0;
+  return static_cast<uint64_t>(budget.convert(millisecond) * 1000);
+}
+}  // namespace rev
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+
+#include "rev/api/units/q_time.hh"
+
+namespace rev {
+
+/**
+ * @brief Timing statistics for a periodically stepped runnable
+ *
+ * The period is measured from the start of one step to the start of the next.
+ */
+struct RunnerStats {
+  uint32_t steps{0};             // Number of completed steps
+  uint32_t missed_deadlines{0};  // Steps which finished after the next step
+                                 // was already due
+  uint32_t budget_overruns{0};   // Steps which took longer than their budget
+  QTime period_min{0.0};
+  QTime period_max{0.0};
+  QTime period_mean{0.0};
+  QTime step_max{0.0};  // Longest time spent inside a single step()
+};
+
+/**
+ * @brief Accumulates RunnerStats from step timestamps
+ *
+ * This is not thread safe on its own. The owner is responsible for guarding
+ * it if the stats are read from another thread.
+ */
+class RunnerStatsRecorder {
+ public:
+  /**
+   * @brief Records one step
+   *
+   * @param start The time step() was entered, in microseconds
+   * @param finish The time step() returned, in microseconds
+   * @param missed_deadline Whether the next deadline had already passed by
+   * the time this step finished
+   * @param over_budget Whether the step took longer than its budget
+   */
+  void record(uint64_t start,
+              uint64_t finish,
+              bool missed_deadline,
+              bool over_budget = false);
+
+  /**
+   * @brief Gets the statistics recorded so far
+   *
+   * @return RunnerStats
+   */
+  RunnerStats get_stats() const;
+
+  /**
+   * @brief Clears all recorded statistics
+   *
+   */
+  void reset();
+
+ private:
+  RunnerStats stats;
+  uint64_t last_start{0};
+  uint64_t period_total{0};  // Sum of all measured periods, in microseconds
+  uint32_t periods{0};       // Number of measured periods
+};
+}  // namespace rev
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "rev/api/async/async_runnable.hh"
+#include "rev/api/async/async_runner.hh"
+#include "rev/api/async/runner_config.hh"
+#include "rev/api/async/runner_stats.hh"
+
+namespace rev {
+
+/**
+ * @brief Suggested values for the order parameter of Scheduler::add
+ *
+ * Anything producing state should be stepped before anything consuming it, so
+ * that controllers never act on a pose which is a tick old.
+ */
+enum SchedulerOrder : int {
+  ODOMETRY_ORDER = 0,
+  SEQUENCER_ORDER = 50,
+  CONTROLLER_ORDER = 100,
+  OUTPUT_ORDER = 200
+};
+
+/**
+ * @brief Cooperative runner which hosts many AsyncRunnables on one thread
+ *
+ * Each runnable has its own period. Whenever the scheduler wakes up, every
+ * runnable which is due is stepped once, in ascending order, and the thread
+ * then sleeps until the next runnable is due. Runnables with equal order are
+ * stepped in the order they were added.
+ *
+ * Runnables must not block in step(), as that delays everything after them.
+ * Each runnable keeps its own RunnerStats, so an overrunning runnable can be
+ * told apart from the ones it delayed.
+ *
+ * The thread is meant to live for the whole program. Switching between
+ * competition modes should pause and resume runnables rather than creating
+ * new schedulers. All of the lifecycle functions are idempotent and may be
+ * called from any thread, but only pause() may be called from inside a step(),
+ * since the others wait for the current tick to finish.
+ */
+class Scheduler {
+ public:
+  /**
+   * @brief Construct a new Scheduler and start its thread
+   *
+   */
+  Scheduler();
+
+  /**
+   * @brief Construct a new Scheduler with the given thread settings and start
+   * its thread
+   *
+   * @param iconfig Priority, stack depth, default step budget and budget
+   * callback. The callback is called with the scheduler locked, so it must not
+   * call back into the scheduler.
+   */
+  explicit Scheduler(RunnerConfig iconfig);
+
+  ~Scheduler();
+
+  /**
+   * @brief Adds a runnable to the scheduler
+   *
+   * This is safe to call while the scheduler is running. The runnable will be
+   * stepped for the first time on the next wakeup.
+   *
+   * @param runnable The runnable to step
+   * @param order Runnables with a lower order are stepped first
+   * @param period Time between steps in milliseconds
+   * @param budget Longest a single step is expected to take. Zero uses the
+   * budget from the RunnerConfig.
+   * @return Scheduler& This scheduler, to allow chaining
+   */
+  Scheduler& add(std::shared_ptr<AsyncRunnable> runnable,
+                 int order = CONTROLLER_ORDER,
+                 uint32_t period = 10,
+                 QTime budget = 0_s);
+
+  /**
+   * @brief Removes a runnable from the scheduler
+   *
+   * Once this returns, the runnable will not be stepped again
+   *
+   * @param runnable
+   */
+  void remove(std::shared_ptr<AsyncRunnable> runnable);
+
+  /**
+   * @brief Gets the timing statistics of a runnable
+   *
+   * @param runnable
+   * @return RunnerStats The statistics, or empty statistics if the runnable
+   * is not part of this scheduler
+   */
+  RunnerStats get_stats(std::shared_ptr<AsyncRunnable> runnable);
+
+  /**
+   * @brief Clears the timing statistics of every runnable
+   *
+   */
+  void reset_stats();
+
+  /**
+   * @brief Starts the thread if it is not already running
+   *
+   */
+  void start();
+
+  /**
+   * @brief Stops the thread and waits for it to exit
+   *
+   * Runnables stay registered, so start() picks up where this left off
+   */
+  void stop_and_join();
+
+  /**
+   * @brief Stops stepping every runnable without stopping the thread
+   *
+   * Once this returns, no runnable is being stepped. Called from inside a
+   * runnable's step(), it lets the current tick finish and takes effect from
+   * the next one.
+   */
+  void pause();
+
+  /**
+   * @brief Resumes stepping after pause()
+   *
+   */
+  void resume();
+
+  /**
+   * @brief Stops stepping one runnable
+   *
+   * Once this returns, the runnable is not being stepped and will not be
+   * stepped again until resume(runnable) is called. This waits for the
+   * current tick, so it must not be called from inside a step(). Use pause()
+   * or a flag the runnable checks instead.
+   *
+   * @param runnable
+   */
+  void pause(std::shared_ptr<AsyncRunnable> runnable);
+
+  /**
+   * @brief Resumes stepping one runnable after pause(runnable)
+   *
+   * Its schedule restarts from the next wakeup, so the steps skipped while it
+   * was paused are not counted as missed deadlines
+   *
+   * @param runnable
+   */
+  void resume(std::shared_ptr<AsyncRunnable> runnable);
+
+  /**
+   * @brief Tells whether the thread is running
+   *
+   * @return true if started and not stopped
+   */
+  bool is_running();
+
+ private:
+  struct Entry {
+    std::shared_ptr<AsyncRunnable> runnable;
+    int order;
+    uint32_t period;      // Time between steps in millis
+    uint32_t next_due;    // Time of the next step in millis
+    bool started{false};  // next_due is only valid once this is set
+    bool paused{false};
+    uint64_t budget_us;   // Budget for one step in micros, or 0 if unchecked
+    RunnerStatsRecorder stats;
+  };
+
+  std::vector<Entry> entries;
+  rmutex entries_mutex;
+
+  RunnerConfig config;
+
+  rthread* thread{nullptr};
+  std::atomic<bool> active{false};
+  std::atomic<bool> paused{false};
+  // The thread running loop(), so pause() can tell it is called from a step
+  std::atomic<const void*> loop_thread{nullptr};
+
+  // Serializes start() and stop_and_join()
+  rmutex lifecycle_mutex;
+
+  // Helper function to launch thread
+  static void run(void* context);
+
+  void loop();
+
+  /**
+   * @brief Steps every due runnable
+   *
+   * @param now The current time in millis
+   * @return uint32_t The time at which the next runnable is due
+   */
+  uint32_t tick(uint32_t now);
+};
+}  // namespace rev
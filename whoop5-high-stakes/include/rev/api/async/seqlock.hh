@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace rev {
+/**
+ * @brief Single-writer, multi-reader publication of a value without locks
+ *
+ * The value is double buffered. The writer always fills the slot readers are
+ * not currently directed at, then bumps a sequence counter to publish it, so
+ * neither side ever waits on the other. A reader only has to retry if the
+ * writer published twice while it was copying, which with a 10 ms writer is
+ * practically never.
+ *
+ * Each slot is stored as 32-bit words which are loaded and stored with
+ * relaxed atomics. They compile to plain loads and stores, but mean a reader
+ * copying a slot the writer is filling is well defined, and the sequence
+ * check then throws that copy away.
+ *
+ * Only one thread may call write() at a time. If several threads need to
+ * write, serialize them with a mutex of their own; readers still never touch
+ * it.
+ *
+ * @tparam T A trivially copyable type
+ */
+template <typename T>
+class Seqlock {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Seqlock requires a trivially copyable type");
+
+ public:
+  Seqlock() : Seqlock(T()) {}
+
+  explicit Seqlock(const T& initial) {
+    store_slot(0, initial);
+    store_slot(1, initial);
+  }
+
+  /**
+   * @brief Publishes a new value
+   *
+   * This is wait-free, but must not be called from two threads at once
+   *
+   * @param value
+   */
+  void write(const T& value) {
+    uint32_t s = sequence.load(std::memory_order_relaxed);
+
+    // An odd sequence marks the write in progress. Readers keep using the slot
+    // selected by s / 2, so we fill the other one.
+    sequence.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    store_slot(((s >> 1) + 1) & 1, value);
+
+    sequence.store(s + 2, std::memory_order_release);
+  }
+
+  /**
+   * @brief Gets a coherent copy of the most recently published value
+   *
+   * This never blocks the writer
+   *
+   * @return T
+   */
+  T read() const {
+    T value;
+    uint32_t before, after;
+    do {
+      before = sequence.load(std::memory_order_acquire);
+      value = load_slot((before >> 1) & 1);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = sequence.load(std::memory_order_relaxed);
+
+      // The slot we copied is only overwritten once the writer has started
+      // the publish after next, which moves the sequence 3 past the last even
+      // value we saw
+    } while (after - (before & ~1u) > 2);
+    return value;
+  }
+
+ private:
+  static constexpr size_t WORDS =
+      (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+  void store_slot(uint32_t slot, const T& value) {
+    uint32_t words[WORDS] = {};
+    std::memcpy(words, &value, sizeof(T));
+    for (size_t i = 0; i < WORDS; i++)
+      slots[slot][i].store(words[i], std::memory_order_relaxed);
+  }
+
+  T load_slot(uint32_t slot) const {
+    uint32_t words[WORDS];
+    for (size_t i = 0; i < WORDS; i++)
+      words[i] = slots[slot][i].load(std::memory_order_relaxed);
+
+    T value;
+    std::memcpy(&value, words, sizeof(T));
+    return value;
+  }
+
+  std::atomic<uint32_t> sequence{0};
+  std::atomic<uint32_t> slots[2][WORDS];
+};
+}  // namespace rev
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace rev {
+/**
+ * @brief Fixed-capacity ring buffer for passing values from one thread to
+ * another without locks or allocation
+ *
+ * Exactly one thread may push and exactly one thread may pop. When the ring is
+ * full, push() drops the new value and counts it as an overflow instead of
+ * blocking, so a slow consumer can never stall the producer.
+ *
+ * @tparam T The type of value stored
+ * @tparam N The capacity, which must be a power of two
+ */
+template <typename T, size_t N>
+class SpscRing {
+  static_assert(N > 0 && (N & (N - 1)) == 0,
+                "SpscRing capacity must be a power of two");
+
+ public:
+  /**
+   * @brief Adds a value to the ring. Only call this from the producer.
+   *
+   * @param value
+   * @return true if the value was added, false if the ring was full
+   */
+  bool push(const T& value) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= N) {
+      overflows.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    slots[h & (N - 1)] = value;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Removes the oldest value from the ring. Only call this from the
+   * consumer.
+   *
+   * @param value Set to the removed value
+   * @return true if a value was removed, false if the ring was empty
+   */
+  bool pop(T& value) {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire))
+      return false;
+
+    value = slots[t & (N - 1)];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Gets the number of values waiting to be popped
+   *
+   * @return size_t
+   */
+  size_t size() const {
+    return head.load(std::memory_order_acquire) -
+           tail.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Gets the number of values dropped because the ring was full
+   *
+   * @return uint32_t
+   */
+  uint32_t get_overflows() const {
+    return overflows.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Gets the capacity of the ring
+   *
+   * @return size_t
+   */
+  static constexpr size_t capacity() { return N; }
+
+ private:
+  T slots[N];
+  std::atomic<uint32_t> head{0};  // Total values pushed
+  std::atomic<uint32_t> tail{0};  // Total values popped
+  std::atomic<uint32_t> overflows{0};
+};
+}  // namespace rev
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+
+#include "rev/api/alg/odometry/odometry_sample.hh"
+#include "rev/api/async/async_runnable.hh"
+#include "rev/api/async/spsc_ring.hh"
+
+namespace rev {
+
+/**
+ * @brief Number of samples an OdometryLogRing holds before dropping new ones
+ *
+ * At one sample every 5 ms this covers 2.5 seconds of stalled writing.
+ */
+constexpr size_t ODOMETRY_LOG_CAPACITY = 512;
+
+/**
+ * @brief Ring used to pass samples from odometry to an OdometryLogWriter
+ *
+ */
+typedef SpscRing<OdometrySample, ODOMETRY_LOG_CAPACITY> OdometryLogRing;
+
+/**
+ * @brief Writes captured odometry samples to a binary log file
+ *
+ * The log is an 8 byte header followed by records of the time in micros
+ * modulo 2^32, both rotation sensors as int32 centidegrees, the heading of
+ * each inertial as a float, and the left and right drive positions as floats,
+ * all little-endian. With one inertial a record is 24 bytes. Run this on its
+ * own low-priority AsyncRunner, since writes to the SD card can take several
+ * milliseconds.
+ */
+class OdometryLogWriter : public AsyncRunnable {
+ public:
+  /**
+   * @brief Construct a new Odometry Log Writer
+   *
+   * @param iring The ring to empty. This writer must be its only consumer.
+   * @param path File to write, such as "/usd/odometry.bin". It is replaced if
+   * it already exists.
+   * @param iinertials How many inertial headings to keep from each sample
+   */
+  OdometryLogWriter(std::shared_ptr<OdometryLogRing> iring,
+                    const char* path,
+                    size_t iinertials = 1);
+  ~OdometryLogWriter();
+
+  /**
+   * @brief Writes every sample currently in the ring to the file
+   *
+   * If the file could not be opened, the samples are discarded
+   */
+  void step() override;
+
+  /**
+   * @brief Returns true if the file was opened
+   *
+   */
+  bool is_open();
+
+ private:
+  std::shared_ptr<OdometryLogRing> ring;
+  std::FILE* file;
+  size_t inertials;
+};
+
+/**
+ * @brief Reads the samples back out of a log written by OdometryLogWriter
+ *
+ */
+class OdometryLogReader {
+ public:
+  /**
+   * @brief Opens a log
+   *
+   * Logs from before multiple inertials were supported are read as having
+   * one, and logs from before drive encoders were logged read them as
+   * PROS_ERR_F
+   *
+   * @param path
+   */
+  explicit OdometryLogReader(const char* path);
+  ~OdometryLogReader();
+
+  /**
+   * @brief Returns true if the file was opened and has a valid header
+   *
+   */
+  bool is_open();
+
+  /**
+   * @brief Reads the next sample
+   *
+   * Times are unwrapped, so they keep increasing past 2^32 micros
+   *
+   * @param sample Set to the next sample
+   * @return true if a sample was read, false at the end of the log
+   */
+  bool next(OdometrySample& sample);
+
+ private:
+  std::FILE* file;
+  uint8_t version{1};
+  size_t inertials{1};
+  uint32_t time_last{0};
+  uint64_t time{0};
+  bool started{false};
+};
+
+/**
+ * @brief Receives each replayed sample and the odometry state after it
+ *
+ */
+typedef std::function<void(const OdometrySample&, const OdometryState&)>
+    ReplaySink;
+
+/**
+ * @brief Feeds every remaining sample in a log through an odometry
+ *
+ * @param log
+ * @param odometry
+ * @param sink Called after each sample is added
+ * @return size_t The number of samples replayed
+ */
+size_t replay_odometry_log(OdometryLogReader& log,
+                           SampledOdometry& odometry,
+                           ReplaySink sink);
+}  // namespace rev
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "rev/api/alg/drive/stop/stop.hh"
+#include "rev/api/alg/odometry/odometry.hh"
+#include "rev/api/async/async_runnable.hh"
+#include "rev/api/async/spsc_ring.hh"
+
+namespace rev {
+/**
+ * @brief One sample of controller state, recorded from inside a control loop
+ *
+ */
+struct TelemetryRecord {
+  uint32_t time;  // Time the sample was taken, in millis from get_clock()
+  Position pos;
+  Velocity vel;
+  double left_power;   // Power commanded to the left side, [-1.0, 1.0]
+  double right_power;  // Power commanded to the right side, [-1.0, 1.0]
+  stop_state stop;
+  uint32_t segment;  // Index of the path segment being followed
+};
+
+/**
+ * @brief Number of records a TelemetryRing holds before dropping new ones
+ *
+ * At one record per 10 ms tick this covers 2.5 seconds of stalled draining.
+ */
+constexpr size_t TELEMETRY_CAPACITY = 256;
+
+/**
+ * @brief Ring used to pass telemetry from a control loop to a TelemetryDrain
+ *
+ */
+typedef SpscRing<TelemetryRecord, TELEMETRY_CAPACITY> TelemetryRing;
+
+/**
+ * @brief Function which receives drained telemetry records
+ *
+ */
+typedef std::function<void(const TelemetryRecord&)> TelemetrySink;
+
+/**
+ * @brief Prints a telemetry record to stdout as one line of CSV
+ *
+ * The columns are time, x, y, theta, xv, yv, angular, left power, right power,
+ * stop state and segment, in millis, inches, degrees and seconds.
+ *
+ * @param record
+ */
+void print_telemetry(const TelemetryRecord& record);
+
+/**
+ * @brief Empties a TelemetryRing into a sink
+ *
+ * Run this on its own low-priority AsyncRunner, so that slow output such as
+ * printing never delays the control loops producing the records.
+ */
+class TelemetryDrain : public AsyncRunnable {
+ public:
+  /**
+   * @brief Construct a new Telemetry Drain
+   *
+   * @param iring The ring to empty. This drain must be its only consumer.
+   * @param isink Receives every record, oldest first
+   */
+  TelemetryDrain(std::shared_ptr<TelemetryRing> iring,
+                 TelemetrySink isink = print_telemetry);
+
+  /**
+   * @brief Passes every record currently in the ring to the sink
+   *
+   */
+  void step() override;
+
+ private:
+  std::shared_ptr<TelemetryRing> ring;
+  TelemetrySink sink;
+};
+}  // namespace rev
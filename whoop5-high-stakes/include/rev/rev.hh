@@ -1,3 +1,6 @@
+// Segment geometry shared by the strategies below
+#include "rev/api/alg/drive/segment_frame.hh"
+
 // Correction
 #include "rev/api/alg/drive/correction/correction.hh"
 #include "rev/api/alg/drive/correction/no_correction.hh"
@@ -7,6 +10,7 @@
 #include "rev/api/alg/drive/motion/motion.hh"
 #include "rev/api/alg/drive/motion/cascading_motion.hh"
 #include "rev/api/alg/drive/motion/constant_motion.hh"
+#include "rev/api/alg/drive/motion/profiled_motion.hh"
 #include "rev/api/alg/drive/motion/proportional_motion.hh"
 
 // Stop
@@ -18,20 +22,51 @@
 #include "rev/api/alg/drive/turn/campbell_turn.hh"
 
 // Odometry
+#include "rev/api/alg/odometry/field_walls.hh"
+#include "rev/api/alg/odometry/fix_corrected_odometry.hh"
+#include "rev/api/alg/odometry/fused_odometry.hh"
+#include "rev/api/alg/odometry/heading_fusion.hh"
 #include "rev/api/alg/odometry/odometry.hh"
+#include "rev/api/alg/odometry/odometry_health.hh"
+#include "rev/api/alg/odometry/odometry_integrator.hh"
+#include "rev/api/alg/odometry/odometry_sample.hh"
+#include "rev/api/alg/odometry/particle_odometry.hh"
+#include "rev/api/alg/odometry/pose_history.hh"
+#include "rev/api/alg/odometry/range_corrected_odometry.hh"
+#include "rev/api/alg/odometry/tracking_wheel_calibration.hh"
+#include "rev/api/alg/odometry/tracking_wheel_odometry.hh"
 #include "rev/api/alg/odometry/two_rotation_inertial_odometry.hh"
+#include "rev/api/alg/odometry/velocity_estimator.hh"
 
 // Reckless
 #include "rev/api/alg/reckless/path.hh"
 #include "rev/api/alg/reckless/reckless.hh"
 
+// Sequence
+#include "rev/api/alg/sequence/action.hh"
+#include "rev/api/alg/sequence/actions.hh"
+#include "rev/api/alg/sequence/sequencer.hh"
+
+// Trajectory following
+#include "rev/api/alg/trajectory/ramsete_follower.hh"
+
 // Chassis
 #include "rev/api/hardware/chassis/chassis.hh"
 #include "rev/api/hardware/chassis/skid_steer_chassis.hh"
 
+// Telemetry
+#include "rev/api/telemetry/odometry_log.hh"
+#include "rev/api/telemetry/telemetry.hh"
+
 // Async
 #include "rev/api/async/async_runnable.hh"
 #include "rev/api/async/async_runner.hh"
+#include "rev/api/async/clock.hh"
+#include "rev/api/async/event.hh"
+#include "rev/api/async/runner_config.hh"
+#include "rev/api/async/scheduler.hh"
+#include "rev/api/async/seqlock.hh"
+#include "rev/api/async/spsc_ring.hh"
 
 // Units
 #include "rev/api/units/all_units.hh"
\ No newline at end of file
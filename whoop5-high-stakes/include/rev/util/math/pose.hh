@@ -29,6 +29,20 @@ struct Pose : public PointVector {
   Pose to_absolute(const Pose reference) const;
 };
 
+/**
+ * @brief Interpolates between two poses along the constant-curvature arc
+ * joining them
+ *
+ * This is interpolation on SE(2), so a robot driving an arc between the two
+ * poses is placed on that arc rather than on the chord between them
+ *
+ * @param from The pose at fraction 0
+ * @param to The pose at fraction 1
+ * @param fraction
+ * @return Pose
+ */
+Pose interpolate(const Pose& from, const Pose& to, double fraction);
+
 constexpr bool operator==(Pose lhs, Pose rhs) {
   // 1 degree precision should be enough
   if (abs(lhs.theta - rhs.theta) > 1_deg)
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace rev {
+/**
+ * @brief Fixed-capacity vector which keeps its elements inline, so it never
+ * allocates
+ *
+ * Elements are contiguous and constructed in place, so it holds types which
+ * have no default constructor. Unlike std::vector, copying it copies the
+ * elements rather than reallocating, and assigning to it destroys the old
+ * elements and copies the new ones in, so the elements don't need to be
+ * assignable.
+ *
+ * @tparam T The type of element stored
+ * @tparam N The capacity
+ */
+template <typename T, size_t N>
+class StaticVector {
+  static_assert(N > 0, "StaticVector capacity must be at least one");
+
+ public:
+  StaticVector() = default;
+
+  StaticVector(const StaticVector& other) {
+    for (const T& value : other)
+      push_back(value);
+  }
+
+  StaticVector(StaticVector&& other) {
+    for (T& value : other)
+      push_back(std::move(value));
+  }
+
+  StaticVector& operator=(const StaticVector& other) {
+    if (this != &other) {
+      clear();
+      for (const T& value : other)
+        push_back(value);
+    }
+    return *this;
+  }
+
+  StaticVector& operator=(StaticVector&& other) {
+    if (this != &other) {
+      clear();
+      for (T& value : other)
+        push_back(std::move(value));
+    }
+    return *this;
+  }
+
+  ~StaticVector() { clear(); }
+
+  /**
+   * @brief Constructs an element in place at the end
+   *
+   * Throws std::length_error if the vector is full
+   *
+   * @return T& The new element
+   */
+  template <typename... Args>
+  T& emplace_back(Args&&... args) {
+    if (count >= N)
+      throw std::length_error("StaticVector is full");
+
+    T* value = new (&storage[count * sizeof(T)]) T(std::forward<Args>(args)...);
+    count++;
+    return *value;
+  }
+
+  /**
+   * @brief Adds an element to the end
+   *
+   * Throws std::length_error if the vector is full
+   *
+   * @param value
+   */
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  /**
+   * @brief Destroys every element
+   *
+   */
+  void clear() {
+    while (count > 0)
+      data()[--count].~T();
+  }
+
+  /**
+   * @brief Gets an element, throwing std::out_of_range if there is none at
+   * that index
+   *
+   * @param i
+   */
+  T& at(size_t i) {
+    if (i >= count)
+      throw std::out_of_range("StaticVector index out of range");
+    return data()[i];
+  }
+  const T& at(size_t i) const {
+    if (i >= count)
+      throw std::out_of_range("StaticVector index out of range");
+    return data()[i];
+  }
+
+  T& operator[](size_t i) { return data()[i]; }
+  const T& operator[](size_t i) const { return data()[i]; }
+
+  T* data() { return std::launder(reinterpret_cast<T*>(storage)); }
+  const T* data() const {
+    return std::launder(reinterpret_cast<const T*>(storage));
+  }
+
+  T* begin() { return data(); }
+  T* end() { return data() + count; }
+  const T* begin() const { return data(); }
+  const T* end() const { return data() + count; }
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  /**
+   * @brief Gets the capacity of the vector
+   *
+   * @return size_t
+   */
+  static constexpr size_t capacity() { return N; }
+
+ private:
+  alignas(T) unsigned char storage[N * sizeof(T)];
+  size_t count{0};
+};
+}  // namespace rev
@@ -1,14 +1,18 @@
 #include "globals.hh"
 #include "rev/rev.hh"
 
-std::shared_ptr<rev::AsyncRunner> odom_runner;
-std::shared_ptr<rev::AsyncRunner> reckless_runner;
-std::shared_ptr<rev::AsyncRunner> turn_runner;
+std::shared_ptr<rev::Scheduler> scheduler;
+std::shared_ptr<rev::AsyncRunner> telemetry_runner;
+std::shared_ptr<rev::AsyncRunner> odometry_log_runner;
+
+std::shared_ptr<rev::TelemetryRing> telemetry;
+std::shared_ptr<rev::OdometryLogRing> odometry_log;
 
 std::shared_ptr<rev::TwoRotationInertialOdometry> odom;
 
 std::shared_ptr<rev::Reckless> reckless;
 std::shared_ptr<rev::CampbellTurn> turn;
+std::shared_ptr<rev::Sequencer> sequencer;
 
 // motor ports
 pros::MotorGroup left_motor_group(LEFT_MOTOR_GROUP);
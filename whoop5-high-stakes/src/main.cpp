@@ -12,6 +12,7 @@
 using namespace rev;
 
 void print_position();
+void calibrate_odometry();
 
 /**
  * Runs initialization code. This occurs as soon as the program is started.
@@ -28,12 +29,15 @@ void initialize() {
     fwd,      // The forward sensor
     lat,      // The rightward sensor 
     imu,      // Inertial sensor
-    WHEEL_DIAMETER,  // Diameter of forward wheel
-    WHEEL_DIAMETER,  // Diameter of sideways wheel
+    FORWARD_WHEEL_DIAMETER,  // Diameter of forward wheel
+    LATERAL_WHEEL_DIAMETER,  // Diameter of sideways wheel
     FORWARD_WHEEL_OFFSET,  // How far to the right of the center of the robot the forward wheel is
     LATERAL_WHEEL_OFFSET    // How far to the rear of the robot the lateral wheel is from the center
   );
 
+  // if a tracking wheel or the IMU stops working, odometry switches over to the drive motor encoders. see get_health()
+  odom->set_drive_encoders(left_motor_group, right_motor_group, {DRIVE_WHEEL_DIAMETER, DRIVE_GEAR_RATIO, DRIVE_TRACK_WIDTH});
+
 
   // creates a turn controller object. This turn controller can only do point turns
   turn = std::make_shared<CampbellTurn>(chassis, odom, TURN_IKP1, TURN_IKP2);
@@ -42,11 +46,43 @@ void initialize() {
   // creates a reckless controller object. This is used to drive the robot to points on the field
   reckless = std::make_shared<Reckless>(chassis, odom);
 
+  // runs autonomous routines made of drive, turn and mechanism actions
+  sequencer = std::make_shared<Sequencer>();
+
+  // logging threads run at the lowest priority so that printing and SD card writes never slow the controllers
+  rev::RunnerConfig telemetry_config;
+  telemetry_config.priority = TASK_PRIORITY_MIN + 1;
+
+  // reckless records its state into the telemetry ring every tick. printing is slow, so it happens on a separate low priority thread
+  if (CAPTURE_TELEMETRY) {
+    telemetry = std::make_shared<rev::TelemetryRing>();
+    reckless->set_telemetry(telemetry);
+    telemetry_runner = std::make_shared<rev::AsyncRunner>(std::make_shared<rev::TelemetryDrain>(telemetry), 50, telemetry_config);
+  }
+
+  // odometry copies its raw sensor readings into a ring, and the SD card is written on a separate low priority thread
+  if (CAPTURE_ODOMETRY) {
+    odometry_log = std::make_shared<rev::OdometryLogRing>();
+    odom->set_capture(odometry_log);
+    odometry_log_runner = std::make_shared<rev::AsyncRunner>(std::make_shared<rev::OdometryLogWriter>(odometry_log, ODOMETRY_LOG_PATH), 100, telemetry_config);
+  }
+
   pros::delay(2000);
 
-    odom_runner = std::make_shared<rev::AsyncRunner>(odom);
-	reckless_runner = std::make_shared<rev::AsyncRunner>(reckless);
-	turn_runner = std::make_shared<rev::AsyncRunner> (turn);
+	// runs above the default priority so that opcontrol and LCD printing can't delay odometry
+	rev::RunnerConfig scheduler_config;
+	scheduler_config.priority = TASK_PRIORITY_DEFAULT + 1;
+	scheduler_config.budget = 2_ms; // every step should take well under one tick; overruns show up in get_stats()
+	scheduler = std::make_shared<rev::Scheduler>(scheduler_config);
+
+	// the sensors refresh every 5ms and odometry checks for new readings every 2ms, so the position reckless sees is at most a few ms old
+	odom->set_data_rate(5);
+
+	// odometry is stepped first so that reckless and turn always see the latest position
+	scheduler->add(odom, rev::ODOMETRY_ORDER, 2)
+	          .add(sequencer, rev::SEQUENCER_ORDER)
+	          .add(reckless, rev::CONTROLLER_ORDER)
+	          .add(turn, rev::CONTROLLER_ORDER);
 
     pros::delay(2000);
     odom->reset_position();
@@ -57,7 +93,12 @@ void initialize() {
  * the VEX Competition Switch, following either autonomous or opcontrol. When
  * the robot is enabled, this task will exit.
  */
-void disabled() {}
+void disabled() {
+	// odometry keeps running so the position is still known when re-enabled
+	sequencer->cancel();
+	scheduler->pause(reckless);
+	scheduler->pause(turn);
+}
 
 /**
  * Runs after initialize(), and before autonomous when connected to the Field
@@ -82,11 +123,11 @@ void competition_initialize() {}
  * from where it left off.
  */
 void autonomous() {
-	odomHydraulic.set_value(0);
+	// the scheduler persists between modes, so this only flips a flag
+	scheduler->resume(reckless);
+	scheduler->resume(turn);
 
-    odom_runner = std::make_shared<rev::AsyncRunner>(odom);
-	reckless_runner = std::make_shared<rev::AsyncRunner>(reckless);
-	turn_runner = std::make_shared<rev::AsyncRunner> (turn);
+	odomHydraulic.set_value(0);
 
 	odom->reset_position();
 
@@ -94,27 +135,23 @@ void autonomous() {
 	print_position();
 
 
-	reckless->go(
-		RecklessPath().with_segment(
-		RecklessPathSegment(
-			std::make_shared<ConstantMotion>(0.2),             // tells the robot to move at 50% power
-			std::make_shared<PilonsCorrection>(4, 0.3_in), // if the robot is 0.3in or more off the path, then it will start correcting that path
-			std::make_shared<SimpleStop>(0.03_s, 0.15_s, 0.3),   // robot will soft stop if it is 0.15 seconds from the finish, and hard stop when it is 0.03 seconds from the finish. Soft stop means that the speed is set to 30% power. Hard stop means that the brakes are applied
-			{ 20_in, 0_in, 0_deg },               // the target global position. Position 0, 0 is where the robot starts. the 0_deg is meaningless but it has to be included for syntax reasons
-			0_in)                                          // tells the robot to stop 0_in from the target
-	));
+	// the whole routine runs on the scheduler thread, so each action starts on the same tick the previous one finishes
+	sequencer->run(sequence({
+		drive_path(reckless, RecklessPath().with_segment(
+			RecklessPathSegment(
+				ConstantMotion(0.2),             // tells the robot to move at 50% power
+				PilonsCorrection(4, 0.3_in), // if the robot is 0.3in or more off the path, then it will start correcting that path
+				SimpleStop(0.03_s, 0.15_s, 0.3),   // robot will soft stop if it is 0.15 seconds from the finish, and hard stop when it is 0.03 seconds from the finish. Soft stop means that the speed is set to 30% power. Hard stop means that the brakes are applied
+				{ 20_in, 0_in, 0_deg },               // the target global position. Position 0, 0 is where the robot starts. the 0_deg is meaningless but it has to be included for syntax reasons
+				0_in)                                          // tells the robot to stop 0_in from the target
+		)),
 
-	while (!reckless->is_completed()) {
-		print_position();
-		pros::delay(20);
-	}
+		// turn the robot 90 degrees with a max power of 70%
+		turn_to(turn, 0.7, 90_deg)
+	}));
 
-	// turn the robot 90 degrees with a max power of 70%
-	turn->turn_to_target_absolute(0.7, 90_deg);
-	
-	while (!turn->is_completed()) {
+	while (!sequencer->await_for(20_ms)) {
 		print_position();
-		pros::delay(20);
 	}
 }
 
@@ -139,6 +176,14 @@ void opcontrol() {
 
 	pros::Controller master(pros::E_CONTROLLER_MASTER); // used to get inputs from the users's controller
 
+	// stop any unfinished autonomous motion from fighting the driver
+	sequencer->cancel();
+	scheduler->pause(reckless);
+	scheduler->pause(turn);
+
+	if (CALIBRATE_ODOMETRY) {
+		calibrate_odometry();
+	}
 
     while (true) {
 		int left = master.get_analog(ANALOG_LEFT_Y);
@@ -181,12 +226,91 @@ void opcontrol() {
 
 
 void print_position() {
+	// Read once so that all three values come from the same odometry step
+	rev::OdometryState state = odom->get_state();
+
 	std::string position = "Position: ";
-	position += std::to_string(odom->get_state().pos.x.convert(inch));
+	position += std::to_string(state.pos.x.convert(inch));
 	position += ", ";
-	position += std::to_string(odom->get_state().pos.y.convert(inch));
+	position += std::to_string(state.pos.y.convert(inch));
 	position += ", ";
-	position += std::to_string(odom->get_state().pos.theta.convert(degree));
+	position += std::to_string(state.pos.theta.convert(degree));
 
 	pros::lcd::set_text(2, position);
-}
\ No newline at end of file
+	pros::lcd::set_text(3, odom->get_health().is_degraded() ? "Odometry degraded: a sensor failed" : "");
+}
+
+/**
+ * Measures the tracking wheels for the odometry constants in globals.hh.
+ *
+ * The robot first spins in place by itself, both ways. Then drive it forward CALIBRATION_DISTANCE between two marks, then back again, twice,
+ * pressing A when it is stopped at the start and at the end of each line. Then push it sideways to the right CALIBRATION_DISTANCE by hand
+ * and back again the same way, for the sideways wheel. The fitted values are printed to the terminal.
+ *
+ * Turn on CAPTURE_ODOMETRY as well to keep the run, so it can be solved again on a computer with tools/calibrate_odometry.cpp using the
+ * segment times printed here.
+ */
+void calibrate_odometry() {
+	pros::Controller master(pros::E_CONTROLLER_MASTER);
+	rev::TrackingWheelCalibrator calibrator;
+
+	// feeds the calibrator until the time is up, or until A is pressed if duration is 0. the driver has the joysticks meanwhile if drive is true
+	auto record = [&](uint32_t duration, bool drive) {
+		uint32_t start = pros::millis();
+		while (duration == 0 ? !master.get_digital_new_press(DIGITAL_A) : pros::millis() - start < duration) {
+			calibrator.add_sample(odom->read_sample());
+			if (drive) {
+				chassis->drive_tank(master.get_analog(ANALOG_LEFT_Y) / 127.0, master.get_analog(ANALOG_RIGHT_Y) / 127.0);
+			}
+			pros::delay(10);
+		}
+	};
+
+	auto segment = [&](const char* name, rev::CalibrationMotion motion, QLength distance, std::function<void()> move) {
+		double start = odom->read_sample().time / 1e6;
+		calibrator.begin_segment(motion, distance);
+		move();
+		chassis->stop();
+		record(750, false); // let the robot come to rest before the segment ends
+		calibrator.end_segment();
+		std::printf("%s:%.2f:%.2f%s\n", name, start, odom->read_sample().time / 1e6,
+		            motion == rev::CalibrationMotion::SPIN ? "" : (":" + std::to_string(distance.convert(inch))).c_str());
+	};
+
+	pros::lcd::set_text(1, "Calibrating: spinning");
+	for (double direction : {1.0, -1.0}) {
+		segment("spin", rev::CalibrationMotion::SPIN, 0_in, [&]() {
+			chassis->drive_tank(0.4 * direction, -0.4 * direction);
+			record(5000, false);
+		});
+	}
+
+	for (int i = 0; i < 4; i++) {
+		QLength distance = i % 2 == 0 ? CALIBRATION_DISTANCE : -CALIBRATION_DISTANCE;
+		pros::lcd::set_text(1, i % 2 == 0 ? "Drive forward to the mark. A at start and end" : "Drive back to the mark. A at start and end");
+		record(0, true);
+		chassis->stop();
+		segment("forward", rev::CalibrationMotion::FORWARD, distance, [&]() { record(0, true); });
+	}
+
+	// the drive can't move sideways, so these are pushed by hand with the motors off
+	for (int i = 0; i < 2; i++) {
+		QLength distance = i % 2 == 0 ? CALIBRATION_DISTANCE : -CALIBRATION_DISTANCE;
+		pros::lcd::set_text(1, i % 2 == 0 ? "Push right to the mark. A at start and end" : "Push left back to the mark. A at start and end");
+		record(0, false);
+		segment("sideways", rev::CalibrationMotion::SIDEWAYS, distance, [&]() { record(0, false); });
+	}
+
+	rev::WheelCalibration result;
+	if (!calibrator.solve(result)) {
+		pros::lcd::set_text(1, "Calibration failed");
+		return;
+	}
+
+	std::printf("#define FORWARD_WHEEL_DIAMETER %.2f_mm\n", result.longitudinal_wheel_diameter.convert(millimeter));
+	std::printf("#define LATERAL_WHEEL_DIAMETER %.2f_mm%s\n", result.lateral_wheel_diameter.convert(millimeter),
+	            result.lateral_diameter_fitted ? "" : " // not fitted, assumed the same as the forward wheel");
+	std::printf("#define FORWARD_WHEEL_OFFSET %.3f_in\n", result.longitudinal_wheel_offset.convert(inch));
+	std::printf("#define LATERAL_WHEEL_OFFSET %.3f_in\n", result.lateral_wheel_offset.convert(inch));
+	pros::lcd::set_text(1, "Calibration done, see terminal");
+}
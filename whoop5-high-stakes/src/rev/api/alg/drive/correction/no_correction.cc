@@ -0,0 +1,10 @@
+#include "rev/api/alg/drive/correction/no_correction.hh"
+
+namespace rev {
+
+std::tuple<double, double> NoCorrection::apply_correction(
+    const SegmentFrame&,
+    std::tuple<double, double> powers) {
+  return powers;
+}
+}  // namespace rev
@@ -0,0 +1,41 @@
+#include "rev/api/alg/drive/correction/pilons_correction.hh"
+
+#include <cmath>
+
+namespace rev {
+
+PilonsCorrection::PilonsCorrection(double ik_correction, QLength imax_error)
+    : k_correction(ik_correction), max_error(imax_error) {}
+
+std::tuple<double, double> PilonsCorrection::apply_correction(
+    const SegmentFrame& frame,
+    std::tuple<double, double> powers) {
+  // The robot relative to the target, facing along the line the way the
+  // segment is driven
+  double direction = frame.reversed ? -1.0 : 1.0;
+  double x = direction * frame.along_track.convert(meter);
+  double y = direction * frame.cross_track.convert(meter);
+  double theta = frame.heading_error.convert(radian);
+
+  // Angle from the robot's heading to the target, folded into
+  // [-90deg, 90deg] so driving in reverse works the same as forwards
+  double angle = std::atan2(y, x) - theta;
+  angle -= std::round(angle / M_PI) * M_PI;
+
+  // Distance from the target to the line the robot is driving along
+  QLength xerr = std::abs(y + std::tan(theta) * x) * meter;
+
+  double correction = abs(max_error) < xerr ? angle * k_correction : 0.0;
+  double left = std::get<0>(powers);
+  double right = std::get<1>(powers);
+  if (left < 0)
+    correction = -correction;
+
+  if (correction > 0)
+    right *= std::exp(-correction);
+  else if (correction < 0)
+    left *= std::exp(correction);
+
+  return std::make_tuple(left, right);
+}
+}  // namespace rev
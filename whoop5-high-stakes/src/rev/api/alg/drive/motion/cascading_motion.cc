@@ -0,0 +1,35 @@
+#include "rev/api/alg/drive/motion/cascading_motion.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "rev/util/mathutil.hh"
+
+namespace rev {
+
+CascadingMotion::CascadingMotion(double ipower,
+                                 double ik_p,
+                                 double ik_b,
+                                 QSpeed imax_v,
+                                 double ik_v)
+    : power(std::abs(ipower)),
+      k_p(std::abs(ik_p)),
+      k_b(std::abs(ik_b)),
+      max_v(abs(imax_v)),
+      k_v(std::abs(ik_v)) {}
+
+std::tuple<double, double> CascadingMotion::gen_powers(
+    const SegmentFrame& frame) {
+  // Distance to the drop point along the robot's heading
+  QLength error = frame.target_ahead -
+                  sgn(frame.target_ahead.get_value()) * frame.drop_early;
+
+  QSpeed v_target = sgn(error.get_value()) *
+                    (1 - std::exp(-k_v * abs(error).convert(inch))) * max_v;
+
+  double out = k_b * v_target.convert(inch / second) +
+               k_p * (v_target - frame.forward_speed).convert(inch / second);
+  out = std::clamp(out, -power, power);
+  return std::make_tuple(out, out);
+}
+}  // namespace rev
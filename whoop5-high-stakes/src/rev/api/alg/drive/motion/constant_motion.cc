@@ -0,0 +1,14 @@
+#include "rev/api/alg/drive/motion/constant_motion.hh"
+
+#include <cmath>
+
+namespace rev {
+
+ConstantMotion::ConstantMotion(double ipower) : power(std::abs(ipower)) {}
+
+std::tuple<double, double> ConstantMotion::gen_powers(
+    const SegmentFrame& frame) {
+  double out = frame.reversed ? -power : power;
+  return std::make_tuple(out, out);
+}
+}  // namespace rev
@@ -0,0 +1,119 @@
+#include "rev/api/alg/drive/motion/profiled_motion.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "rev/api/async/clock.hh"
+
+namespace rev {
+
+ProfiledMotion::ProfiledMotion(double ipower,
+                               QSpeed imax_v,
+                               QAcceleration imax_a,
+                               double ik_v,
+                               double ik_a,
+                               double ik_p,
+                               double ik_d,
+                               double ifinish_power)
+    : power(std::abs(ipower)),
+      max_v(abs(imax_v)),
+      max_a(abs(imax_a)),
+      k_v(ik_v),
+      k_a(ik_a),
+      k_p(ik_p),
+      k_d(ik_d),
+      finish_power(std::abs(ifinish_power)) {}
+
+void ProfiledMotion::plan(const SegmentFrame& frame) {
+  segment_start_time = frame.start_time;
+  segment_start = frame.start;
+  segment_target = frame.target;
+  planned = true;
+
+  distance = std::max(frame.length - frame.drop_early, 0_m);
+  v_start = std::max(frame.reversed ? -1 * frame.forward_speed
+                                    : frame.forward_speed,
+                     0_mps);
+
+  accel = max_a;
+  decel = max_a;
+  accel_time = cruise_time = decel_time = 0_s;
+  v_peak = v_start;
+  if (distance == 0_m || max_a == 0_mps2) {
+    v_peak = 0_mps;
+    return;
+  }
+
+  QLength accel_distance = 0_m;
+  if (v_start * v_start >= 2 * max_a * distance) {
+    // Too fast to stop in time at the maximum acceleration, so brake harder
+    decel = v_start * v_start / (2 * distance);
+  } else {
+    // Peak of a triangular profile, unless that is above the maximum
+    v_peak = std::min(max_v, sqrt((2 * max_a * distance + v_start * v_start) /
+                                  2));
+    accel = v_peak >= v_start ? max_a : -max_a;
+    accel_time = abs(v_peak - v_start) / max_a;
+    accel_distance = (v_peak * v_peak - v_start * v_start) / (2 * accel);
+  }
+
+  decel_time = v_peak / decel;
+  QLength decel_distance = v_peak * v_peak / (2 * decel);
+  QLength cruise_distance =
+      std::max(distance - accel_distance - decel_distance, 0_m);
+  if (v_peak > 0_mps)
+    cruise_time = cruise_distance / v_peak;
+}
+
+std::tuple<double, double> ProfiledMotion::gen_powers(
+    const SegmentFrame& frame) {
+  if (!planned || frame.start_time != segment_start_time ||
+      !(frame.start == segment_start) || !(frame.target == segment_target))
+    plan(frame);
+
+  QTime t = (get_clock().millis() - segment_start_time) * millisecond;
+
+  // Sample the profile
+  QLength s_ref = distance;
+  QSpeed v_ref = 0_mps;
+  QAcceleration a_ref = 0_mps2;
+  if (t < accel_time) {
+    s_ref = v_start * t + accel * t * t / 2;
+    v_ref = v_start + accel * t;
+    a_ref = accel;
+  } else if (t < accel_time + cruise_time) {
+    QTime cruising = t - accel_time;
+    s_ref = (v_peak * v_peak - v_start * v_start) / (2 * accel) +
+            v_peak * cruising;
+    v_ref = v_peak;
+  } else if (t < accel_time + cruise_time + decel_time) {
+    QTime braking = accel_time + cruise_time + decel_time - t;
+    s_ref = distance - decel * braking * braking / 2;
+    v_ref = decel * braking;
+    a_ref = -decel;
+  }
+
+  // Where the robot is along the line from the start to the target, and how
+  // fast it is moving along it
+  QLength s = frame.length + frame.along_track;
+  double c = frame.direction.x.convert(meter);
+  double sn = frame.direction.y.convert(meter);
+  QSpeed v = c * frame.state.vel.xv + sn * frame.state.vel.yv;
+
+  double out = k_v * v_ref.convert(inch / second) +
+               k_a * a_ref.convert(inch / (second * second)) +
+               k_p * (s_ref - s).convert(inch) +
+               k_d * (v_ref - v).convert(inch / second);
+
+  // Past the end of the profile and still short, push on through the drop
+  // point rather than easing up to it
+  if (t >= accel_time + cruise_time + decel_time && s < distance)
+    out = std::max(out, finish_power);
+
+  out = std::clamp(out, -power, power);
+  if (frame.reversed)
+    out = -out;
+
+  return std::make_tuple(out, out);
+}
+}  // namespace rev
@@ -0,0 +1,22 @@
+#include "rev/api/alg/drive/motion/proportional_motion.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "rev/util/mathutil.hh"
+
+namespace rev {
+
+ProportionalMotion::ProportionalMotion(double ipower, double ik_p)
+    : power(std::abs(ipower)), k_p(ik_p) {}
+
+std::tuple<double, double> ProportionalMotion::gen_powers(
+    const SegmentFrame& frame) {
+  // Distance to the drop point along the robot's heading
+  QLength error = frame.target_ahead -
+                  sgn(frame.target_ahead.get_value()) * frame.drop_early;
+
+  double out = std::clamp(k_p * error.convert(inch), -power, power);
+  return std::make_tuple(out, out);
+}
+}  // namespace rev
@@ -0,0 +1,58 @@
+#include "rev/api/alg/drive/segment_frame.hh"
+
+#include <cmath>
+
+#include "rev/api/async/clock.hh"
+
+namespace rev {
+
+namespace {
+// Wraps an angle into [-180deg, 180deg)
+QAngle constrain_angle(QAngle angle) {
+  return angle - 360_deg * floor((angle + 180_deg) / 360_deg);
+}
+}  // namespace
+
+void SegmentFrame::begin(const Position& istart,
+                         const Position& itarget,
+                         QLength idrop_early) {
+  start = istart;
+  target = itarget;
+  drop_early = idrop_early;
+
+  PointVector segment = target - start;
+  length = abs(segment);
+  line_angle = atan2(segment.y, segment.x);
+  direction = unit_from_angle(line_angle);
+  reversed = segment * unit_from_angle(start.theta) < 0_m * 0_m;
+  facing_angle = reversed ? line_angle + 180_deg : line_angle;
+  start_time = get_clock().millis();
+}
+
+void SegmentFrame::update(const OdometryState& istate) {
+  state = istate;
+
+  // Robot position relative to the target, in the frame of the line
+  PointVector offset = state.pos - target;
+  double c = direction.x.convert(meter);
+  double s = direction.y.convert(meter);
+  along_track = c * offset.x + s * offset.y;
+  cross_track = c * offset.y - s * offset.x;
+  distance_remaining = -along_track - drop_early;
+
+  heading_error = constrain_angle(state.pos.theta - facing_angle);
+
+  // The only trigonometry done per step
+  double heading_c = std::cos(state.pos.theta.convert(radian));
+  double heading_s = std::sin(state.pos.theta.convert(radian));
+  target_ahead = -(heading_c * offset.x + heading_s * offset.y);
+  speed = sqrt(state.vel.xv * state.vel.xv + state.vel.yv * state.vel.yv);
+  forward_speed = heading_c * state.vel.xv + heading_s * state.vel.yv;
+}
+
+double SegmentFrame::progress() const {
+  if (length == 0_m)
+    return 1.0;
+  return ((along_track + length) / length).get_value();
+}
+}  // namespace rev
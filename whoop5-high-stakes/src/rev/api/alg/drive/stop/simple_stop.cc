@@ -0,0 +1,66 @@
+#include "rev/api/alg/drive/stop/simple_stop.hh"
+
+#include <cmath>
+
+#include "rev/api/async/clock.hh"
+
+namespace rev {
+
+SimpleStop::SimpleStop(QTime iharsh_threshold,
+                       QTime icoast_threshold,
+                       double icoast_power)
+    : harsh_threshold(iharsh_threshold),
+      coast_threshold(icoast_threshold),
+      coast_power(std::abs(icoast_power)) {}
+
+SimpleStop::SimpleStop(QTime iharsh_threshold,
+                       QTime icoast_threshold,
+                       double icoast_power,
+                       QTime itimeout)
+    : harsh_threshold(iharsh_threshold),
+      coast_threshold(icoast_threshold),
+      coast_power(std::abs(icoast_power)),
+      timeout(itimeout.convert(millisecond)) {}
+
+stop_state SimpleStop::get_stop_state(const SegmentFrame& frame) {
+  if (timeout) {
+    uint32_t now = get_clock().millis();
+    if (time_init == 0)
+      time_init = now;
+    else if (time_init + timeout < now)
+      return stop_state::EXIT;
+  }
+
+  // Measured along the line from the start point to the target, so that
+  // sideways error does not count as distance remaining
+  QLength distance_remaining = frame.distance_remaining;
+  QSpeed speed = frame.speed;
+
+  // Past the target
+  if (distance_remaining < 0_m) {
+    stop_state_last = stop_state::BRAKE;
+    if (harsh_threshold > 1_ms)
+      return stop_state::BRAKE;
+    return stop_state::EXIT;
+  }
+
+  // Once braking, keep braking
+  if (distance_remaining < speed * harsh_threshold ||
+      stop_state_last == stop_state::BRAKE) {
+    stop_state_last = stop_state::BRAKE;
+    return stop_state::BRAKE;
+  }
+
+  if (distance_remaining < speed * coast_threshold ||
+      stop_state_last == stop_state::COAST) {
+    stop_state_last = stop_state::COAST;
+    return stop_state::COAST;
+  }
+
+  return stop_state::GO;
+}
+
+double SimpleStop::get_coast_power() {
+  return coast_power;
+}
+}  // namespace rev
@@ -0,0 +1,122 @@
+#include "rev/api/alg/drive/turn/campbell_turn.hh"
+
+#include <cmath>
+
+#include "rev/api/async/clock.hh"
+
+namespace rev {
+
+namespace {
+// Wraps an angle into [-180deg, 180deg)
+QAngle constrain_angle(QAngle angle) {
+  return angle - 360_deg * floor((angle + 180_deg) / 360_deg);
+}
+}  // namespace
+
+CampbellTurn::CampbellTurn(std::shared_ptr<Chassis> ichassis,
+                           std::shared_ptr<Odometry> iodometry,
+                           double ikP1,
+                           double ikP2)
+    : kP1(ikP1), kP2(ikP2) {
+  chassis = ichassis;
+  odometry = iodometry;
+  done.set();
+}
+
+void CampbellTurn::turn_to_target_absolute(double max_power, QAngle angle) {
+  this->max_power = max_power;
+  angle_goal = angle;
+
+  angle_difference = angle_goal - odometry->get_state().pos.theta;
+  target_relative_original = constrain_angle(angle_difference);
+  angle_goal = odometry->get_state().pos.theta + target_relative_original;
+  target_relative = constrain_angle(angle_difference);
+
+  done.clear();
+  controller_state = TurnState::FULLPOWER;
+
+  if (target_relative < 0_deg) {
+    left_direction = -1;
+    right_direction = 1;
+  } else {
+    left_direction = 1;
+    right_direction = -1;
+  }
+}
+
+void CampbellTurn::step() {
+  if (controller_state == TurnState::INACTIVE)
+    return;
+
+  OdometryState current_state = odometry->get_state();
+
+  switch (controller_state) {
+    case TurnState::FULLPOWER:
+      chassis->drive_tank(left_direction * max_power,
+                          right_direction * max_power);
+      break;
+    case TurnState::COAST:
+      chassis->drive_tank(left_direction * coast_turn_power,
+                          right_direction * coast_turn_power);
+      break;
+    case TurnState::BRAKE:
+      if (brake_start_time == -1) {
+        brake_start_time = get_clock().millis();
+        chassis->set_brake_harsh();
+        chassis->stop();
+      }
+
+      if (get_clock().millis() - brake_start_time > 250) {
+        chassis->set_brake_coast();
+        controller_state = TurnState::INACTIVE;
+        brake_start_time = -1;
+        done.set();
+        return;
+      }
+      break;
+    default:
+      break;
+  }
+
+  angle_difference = angle_goal - current_state.pos.theta;
+  target_relative = constrain_angle(angle_difference);
+
+  // Switch to coasting once the remaining angle could be covered in kP1
+  // seconds at the current angular velocity, and to braking at kP2 seconds
+  if (std::abs(target_relative.convert(degree)) <
+      std::abs(odometry->get_state().vel.angular.convert(degree / second) * kP1)) {
+    if (controller_state != TurnState::COAST &&
+        controller_state != TurnState::BRAKE)
+      controller_state = TurnState::COAST;
+  }
+
+  if (std::abs(target_relative.convert(degree)) <
+      std::abs(odometry->get_state().vel.angular.convert(degree / second) * kP2)) {
+    if (controller_state != TurnState::BRAKE)
+      controller_state = TurnState::BRAKE;
+  }
+}
+
+void CampbellTurn::await() {
+  done.wait();
+}
+
+bool CampbellTurn::await_for(QTime timeout) {
+  return done.wait_for(timeout);
+}
+
+bool CampbellTurn::is_completed() {
+  return controller_state == TurnState::INACTIVE;
+}
+
+void CampbellTurn::breakout() {
+  if (controller_state == TurnState::INACTIVE)
+    return;
+
+  controller_state = TurnState::INACTIVE;
+  brake_start_time = -1;
+  chassis->set_brake_coast();
+  chassis->stop();
+  done.set();
+}
+}  // namespace rev
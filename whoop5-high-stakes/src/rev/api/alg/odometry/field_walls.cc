@@ -0,0 +1,15 @@
+#include "rev/api/alg/odometry/field_walls.hh"
+
+namespace rev {
+
+FieldWalls FieldWalls::perimeter(QLength width) {
+  QLength half = width / 2;
+  PointVector corners[4] = {
+      {half, half}, {half, -half}, {-half, -half}, {-half, half}};
+
+  FieldWalls field;
+  for (int i = 0; i < 4; i++)
+    field.walls.push_back({corners[i], corners[(i + 1) % 4]});
+  return field;
+}
+}  // namespace rev
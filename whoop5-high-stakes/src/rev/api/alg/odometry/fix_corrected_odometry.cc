@@ -0,0 +1,216 @@
+#include "rev/api/alg/odometry/fix_corrected_odometry.hh"
+
+#include <cmath>
+#include <mutex>
+
+namespace rev {
+
+namespace {
+// Wraps an angle in radians into [-pi, pi)
+double wrap_radians(double angle) {
+  return angle - std::floor((angle + M_PI) / (2 * M_PI)) * (2 * M_PI);
+}
+
+// Inverts a symmetric 3x3 matrix. Returns false if it is singular.
+bool invert(const double m[3][3], double out[3][3]) {
+  double c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+  double c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+  double c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+  double det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+  if (det <= 0)
+    return false;
+
+  out[0][0] = c00 / det;
+  out[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) / det;
+  out[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) / det;
+  out[1][0] = c01 / det;
+  out[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) / det;
+  out[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) / det;
+  out[2][0] = c02 / det;
+  out[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) / det;
+  out[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) / det;
+  return true;
+}
+}  // namespace
+
+FixCorrectedOdometry::FixCorrectedOdometry(std::shared_ptr<Odometry> iodometry,
+                                           FusionConfig iconfig)
+    : odometry(iodometry), config(iconfig) {
+  odometry_last = odometry->get_state().pos;
+}
+
+OdometryState FixCorrectedOdometry::get_state() {
+  return published_state.read();
+}
+
+void FixCorrectedOdometry::set_position(Position pos) {
+  std::lock_guard<rmutex> lock(estimate_mutex);
+
+  estimate = pos;
+  for (auto& row : covariance)
+    for (double& value : row)
+      value = 0;
+  odometry_last = odometry->get_state().pos;
+  seeded = true;
+  rejected_in_row = 0;
+
+  published_state.write({estimate, {0_mps, 0_mps, 0_deg / second}});
+}
+
+void FixCorrectedOdometry::reset_position() {
+  set_position({0_in, 0_in, 0_deg});
+}
+
+uint32_t FixCorrectedOdometry::get_rejected_fixes() {
+  return rejected_total.load();
+}
+
+uint32_t FixCorrectedOdometry::get_reseeds() {
+  return reseeds.load();
+}
+
+void FixCorrectedOdometry::update() {
+  std::lock_guard<rmutex> lock(estimate_mutex);
+  publish(predict());
+}
+
+void FixCorrectedOdometry::update(Pose fix, QLength error) {
+  std::lock_guard<rmutex> lock(estimate_mutex);
+  OdometryState state = predict();
+  if (error >= 0_in && error <= config.max_gps_error)
+    correct(fix, error);
+  publish(state);
+}
+
+void FixCorrectedOdometry::publish(const OdometryState& state) {
+  // The inner odometry's velocity is in its own frame, which is rotated from
+  // the field by however much the heading has been corrected
+  double rotation =
+      estimate.theta.convert(radian) - state.pos.theta.convert(radian);
+  double c = std::cos(rotation);
+  double s = std::sin(rotation);
+  Velocity vel{c * state.vel.xv - s * state.vel.yv,
+               s * state.vel.xv + c * state.vel.yv, state.vel.angular};
+
+  published_state.write({estimate, vel});
+}
+
+OdometryState FixCorrectedOdometry::predict() {
+  OdometryState state = odometry->get_state();
+
+  // Motion of the inner odometry in the robot frame, replayed from the
+  // estimate
+  Pose motion = state.pos.to_relative(odometry_last);
+  odometry_last = state.pos;
+
+  Pose next = motion.to_absolute(estimate);
+  next.theta = wrap_radians(next.theta.convert(radian)) * radian;
+
+  double dx = (next.x - estimate.x).convert(meter);
+  double dy = (next.y - estimate.y).convert(meter);
+  double distance = std::hypot(dx, dy);
+  double turn = std::abs(wrap_radians(motion.theta.convert(radian)));
+  estimate = next;
+
+  if (!seeded || (distance == 0 && turn == 0))
+    return state;
+
+  // P = F P F^T + Q, where F is the identity except that the travel swings
+  // with any error in heading
+  double(&p)[3][3] = covariance;
+  double p02 = p[0][2] - dy * p[2][2];
+  double p12 = p[1][2] + dx * p[2][2];
+  p[0][0] += -2 * dy * p[0][2] + dy * dy * p[2][2];
+  p[1][1] += 2 * dx * p[1][2] + dx * dx * p[2][2];
+  p[0][1] += dx * p[0][2] - dy * p[1][2] - dx * dy * p[2][2];
+  p[1][0] = p[0][1];
+  p[0][2] = p[2][0] = p02;
+  p[1][2] = p[2][1] = p12;
+
+  double translation_variance =
+      config.translation_noise * config.translation_noise * distance;
+  p[0][0] += translation_variance;
+  p[1][1] += translation_variance;
+  p[2][2] += config.rotation_noise * config.rotation_noise * turn;
+  return state;
+}
+
+void FixCorrectedOdometry::correct(Pose fix, QLength error) {
+  double position_variance = error.convert(meter) * error.convert(meter);
+  double heading_variance =
+      config.gps_heading_error.convert(radian) *
+      config.gps_heading_error.convert(radian);
+  double noise[3] = {position_variance, position_variance, heading_variance};
+
+  auto seed = [&]() {
+    estimate = fix;
+    estimate.theta = wrap_radians(fix.theta.convert(radian)) * radian;
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++)
+        covariance[i][j] = i == j ? noise[i] : 0;
+    seeded = true;
+    rejected_in_row = 0;
+  };
+
+  if (!seeded) {
+    seed();
+    return;
+  }
+
+  double innovation[3] = {
+      (fix.x - estimate.x).convert(meter), (fix.y - estimate.y).convert(meter),
+      wrap_radians((fix.theta - estimate.theta).convert(radian))};
+
+  double(&p)[3][3] = covariance;
+  double s[3][3];
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      s[i][j] = p[i][j] + (i == j ? noise[i] : 0);
+
+  double s_inverse[3][3];
+  if (!invert(s, s_inverse))
+    return;
+
+  // Squared Mahalanobis distance of the fix from the estimate
+  double distance = 0;
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      distance += innovation[i] * s_inverse[i][j] * innovation[j];
+
+  if (distance > config.outlier_gate * config.outlier_gate) {
+    rejected_total++;
+    if (config.reseed_after > 0 && ++rejected_in_row >= config.reseed_after) {
+      seed();
+      reseeds++;
+    }
+    return;
+  }
+  rejected_in_row = 0;
+
+  double gain[3][3];
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      gain[i][j] = p[i][0] * s_inverse[0][j] + p[i][1] * s_inverse[1][j] +
+                   p[i][2] * s_inverse[2][j];
+
+  double correction[3];
+  for (int i = 0; i < 3; i++)
+    correction[i] = gain[i][0] * innovation[0] + gain[i][1] * innovation[1] +
+                    gain[i][2] * innovation[2];
+
+  estimate.x += correction[0] * meter;
+  estimate.y += correction[1] * meter;
+  estimate.theta =
+      wrap_radians(estimate.theta.convert(radian) + correction[2]) * radian;
+
+  // P = (I - K) P, symmetrized against rounding
+  double updated[3][3];
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      updated[i][j] = p[i][j] - (gain[i][0] * p[0][j] + gain[i][1] * p[1][j] +
+                                 gain[i][2] * p[2][j]);
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      p[i][j] = (updated[i][j] + updated[j][i]) * 0.5;
+}
+}  // namespace rev
@@ -0,0 +1,30 @@
+#include "rev/api/alg/odometry/fused_odometry.hh"
+
+#include "pros/error.h"
+
+namespace rev {
+FusedOdometry::FusedOdometry(std::shared_ptr<Odometry> iodometry,
+                             pros::Gps igps,
+                             FusionConfig iconfig)
+    : FixCorrectedOdometry(iodometry, iconfig), gps(igps) {}
+
+void FusedOdometry::step() {
+  // The GPS only refreshes every few steps. Identical readings are the same
+  // fix, and fusing a fix more than once would overweight it.
+  pros::c::gps_status_s_t fix = gps.get_status();
+  if (fix.x == PROS_ERR_F ||
+      (fix.x == fix_last.x && fix.y == fix_last.y && fix.yaw == fix_last.yaw)) {
+    update();
+    return;
+  }
+  fix_last = fix;
+
+  double heading = gps.get_heading();
+  double error = gps.get_error();
+  if (heading == PROS_ERR_F || error == PROS_ERR_F) {
+    update();
+    return;
+  }
+  update({fix.y * meter, fix.x * meter, heading * degree}, error * meter);
+}
+}  // namespace rev
@@ -0,0 +1,145 @@
+#include "rev/api/alg/odometry/heading_fusion.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "pros/error.h"
+
+namespace rev {
+
+namespace {
+// Wraps an angle in degrees into [-180, 180)
+double wrap_degrees(double angle) {
+  return angle - std::floor((angle + 180.0) / 360.0) * 360.0;
+}
+
+// PROS_ERR_F is infinity, so this also catches unplugged sensors
+bool is_reading(double heading) {
+  return std::isfinite(heading);
+}
+}  // namespace
+
+HeadingFusion::HeadingFusion(const HeadingFusionConfig& iconfig)
+    : config(iconfig) {}
+
+void HeadingFusion::reset(const OdometrySample& sample) {
+  size_t count = std::min(sample.inertial_count(), MAX_INERTIALS);
+  bool has_heading = false;
+  for (size_t i = 0; i < MAX_INERTIALS; i++) {
+    double raw = i < count ? sample.inertial_heading(i) : PROS_ERR_F;
+    has_reading[i] = is_reading(raw);
+    if (!has_reading[i])
+      continue;
+
+    raw_last[i] = raw;
+    changed_time[i] = sample.time;
+    if (!has_heading) {
+      heading = raw;
+      has_heading = true;
+    }
+  }
+
+  variance = 0;
+  time_last = sample.time;
+  still_since = sample.time;
+  rate = 0;
+  stationary = false;
+}
+
+double HeadingFusion::update(const OdometrySample& sample, bool wheels_still) {
+  uint64_t time = sample.time;
+  double dt = (time - time_last) * 0.000001;
+  time_last = time;
+
+  size_t count = std::min(sample.inertial_count(), MAX_INERTIALS);
+  double bias_time = config.bias_time_constant.convert(second);
+  double turn_sum = 0;
+  double scale_variance = 0;
+  size_t used = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    double raw = sample.inertial_heading(i);
+    if (!is_reading(raw)) {
+      has_reading[i] = false;
+      continue;
+    }
+
+    // A sensor which has just come back has no reading to difference against
+    if (!has_reading[i]) {
+      raw_last[i] = raw;
+      changed_time[i] = time;
+      has_reading[i] = true;
+      continue;
+    }
+
+    // The inertials refresh slower than samples arrive, so the bias is taken
+    // out over the whole time since each one last changed
+    double turn = 0;
+    if (raw != raw_last[i]) {
+      double span = (time - changed_time[i]) * 0.000001;
+      double reported = wrap_degrees(raw - raw_last[i]) * config.scales[i];
+
+      // Anything a stationary inertial reports is bias
+      if (stationary && config.estimate_bias && span > 0) {
+        double gain = std::min(span / bias_time, 1.0);
+        bias[i] += gain * (reported / span - bias[i]);
+      }
+
+      turn = reported - bias[i] * span;
+      scale_variance += std::pow(config.scale_noise * reported, 2);
+      raw_last[i] = raw;
+      changed_time[i] = time;
+    }
+
+    turn_sum += turn;
+    used++;
+  }
+
+  if (used == 0 || dt <= 0)
+    return heading;
+
+  double turn = turn_sum / used;
+
+  // The rate is low-passed over the stationary time, since each inertial
+  // only shows its turn in steps when it refreshes. It restarts from zero
+  // when the wheels stop, so a fast turn doesn't take long to decay out.
+  double window = config.stationary_time.convert(second);
+  if (!wheels_still) {
+    still_since = time;
+    rate = 0;
+  } else {
+    rate += std::min(dt / window, 1.0) * (turn / dt - rate);
+  }
+  stationary = (time - still_since) * 0.000001 >= window &&
+               std::abs(rate) < config.stationary_rate.convert(degree / second);
+
+  // A zero-velocity update holds the heading, and with it the variance
+  if (!stationary) {
+    heading += turn;
+    variance += (std::pow(config.drift_noise, 2) * dt * used + scale_variance) /
+                (used * used);
+  }
+
+  return heading;
+}
+
+double HeadingFusion::get_heading() const {
+  return heading;
+}
+
+double HeadingFusion::get_variance() const {
+  return variance;
+}
+
+void HeadingFusion::clear_variance() {
+  variance = 0;
+}
+
+double HeadingFusion::get_bias(size_t i) const {
+  return i < MAX_INERTIALS ? bias[i] : 0;
+}
+
+bool HeadingFusion::is_stationary() const {
+  return stationary;
+}
+}  // namespace rev
@@ -0,0 +1,40 @@
+#include "rev/api/alg/odometry/odometry_integrator.hh"
+
+#include <cmath>
+
+namespace rev {
+
+PointVector integrate_odometry(OdometryIntegrator integrator,
+                               const OdometryDelta& delta,
+                               QLength longitudinal_offset,
+                               QLength lateral_offset) {
+  double longitudinal = delta.longitudinal.convert(meter);
+  double lateral = delta.lateral.convert(meter);
+  double heading_delta = delta.heading_delta.convert(radian);
+
+  // Travel of the center of rotation in the robot frame. The wheels also roll
+  // when the robot turns in place, by their offset times the turn, so that
+  // part is removed. For the exponential map, the arc is replaced by its chord.
+  double scale = 1.0;
+  if (integrator == OdometryIntegrator::EXPONENTIAL && heading_delta != 0)
+    scale = 2 * std::sin(heading_delta * 0.5) / heading_delta;
+
+  double local_longitudinal =
+      scale * (longitudinal + longitudinal_offset.convert(meter) * heading_delta);
+  double local_lateral =
+      scale * (lateral + lateral_offset.convert(meter) * heading_delta);
+
+  // Heading the local travel is rotated by. The chord of an arc points along
+  // the average heading, which is also what the midpoint rule uses.
+  double heading = delta.heading.convert(radian);
+  if (integrator == OdometryIntegrator::EULER)
+    heading -= heading_delta;
+  else
+    heading -= heading_delta * 0.5;
+
+  double radius = std::hypot(local_lateral, local_longitudinal);
+  double angle = std::atan2(local_longitudinal, local_lateral) - heading;
+
+  return {radius * std::sin(angle) * meter, radius * std::cos(angle) * meter};
+}
+}  // namespace rev
@@ -0,0 +1,41 @@
+#include "rev/api/alg/odometry/particle_odometry.hh"
+
+#include "pros/error.h"
+
+namespace rev {
+
+namespace {
+std::vector<Pose> offsets_of(const std::vector<DistanceSensorMount>& sensors) {
+  std::vector<Pose> offsets;
+  for (const DistanceSensorMount& mount : sensors)
+    offsets.push_back(mount.offset);
+  return offsets;
+}
+}  // namespace
+
+ParticleOdometry::ParticleOdometry(std::shared_ptr<Odometry> iodometry,
+                                   FieldWalls ifield,
+                                   std::vector<DistanceSensorMount> isensors,
+                                   ParticleConfig iconfig)
+    : RangeCorrectedOdometry(iodometry, ifield, offsets_of(isensors), iconfig),
+      sensors(isensors),
+      min_confidence(iconfig.min_confidence),
+      readings(isensors.size(), 0_m) {}
+
+void ParticleOdometry::step() {
+  if (!is_update_due()) {
+    update(nullptr);
+    return;
+  }
+
+  for (size_t i = 0; i < sensors.size(); i++) {
+    int32_t reading = sensors[i].sensor.get();
+    if (reading == PROS_ERR ||
+        sensors[i].sensor.get_confidence() < min_confidence)
+      readings[i] = 0_m;
+    else
+      readings[i] = reading * millimeter;
+  }
+  update(readings.data());
+}
+}  // namespace rev
@@ -0,0 +1,289 @@
+#include "rev/api/alg/odometry/range_corrected_odometry.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace rev {
+
+namespace {
+// Range given to rays which hit no wall, in meters
+constexpr float NO_HIT = 1e6f;
+
+// Wraps an angle in radians into [-pi, pi)
+double wrap_radians(double angle) {
+  return angle - std::floor((angle + M_PI) / (2 * M_PI)) * (2 * M_PI);
+}
+}  // namespace
+
+RangeCorrectedOdometry::RangeCorrectedOdometry(
+    std::shared_ptr<Odometry> iodometry,
+    FieldWalls ifield,
+    std::vector<Pose> isensor_offsets,
+    ParticleConfig iconfig)
+    : odometry(iodometry),
+      field(ifield),
+      sensor_offsets(isensor_offsets),
+      config(iconfig),
+      rng_state(iconfig.seed != 0 ? iconfig.seed : 1) {
+  config.particles = std::max<size_t>(config.particles, 1);
+  size_t n = config.particles;
+  for (auto* v : {&xs, &ys, &thetas, &weights, &cos_thetas, &sin_thetas,
+                  &ray_xs, &ray_ys, &ray_dxs, &ray_dys, &ranges,
+                  &resampled_xs, &resampled_ys, &resampled_thetas})
+    v->resize(n);
+
+  odometry_last = odometry->get_state().pos;
+  scatter(odometry_last);
+}
+
+OdometryState RangeCorrectedOdometry::get_state() {
+  return published_state.read();
+}
+
+void RangeCorrectedOdometry::set_position(Position pos) {
+  std::lock_guard<rmutex> lock(particles_mutex);
+  odometry_last = odometry->get_state().pos;
+  scatter(pos);
+}
+
+void RangeCorrectedOdometry::reset_position() {
+  set_position({0_in, 0_in, 0_deg});
+}
+
+bool RangeCorrectedOdometry::is_update_due() {
+  return steps_since_update + 1 >= config.update_period;
+}
+
+void RangeCorrectedOdometry::update(const QLength* ranges) {
+  OdometryState state = odometry->get_state();
+
+  std::lock_guard<rmutex> lock(particles_mutex);
+
+  Pose motion = state.pos.to_relative(odometry_last);
+  motion.theta = wrap_radians(motion.theta.convert(radian)) * radian;
+  odometry_last = state.pos;
+  predict(motion);
+
+  if (++steps_since_update >= config.update_period && moved_since_update &&
+      ranges) {
+    bool weighed = false;
+    for (size_t i = 0; i < sensor_offsets.size(); i++) {
+      if (ranges[i] <= 0_m || ranges[i] > config.max_range)
+        continue;
+
+      weigh(sensor_offsets[i], ranges[i]);
+      weighed = true;
+    }
+
+    if (weighed) {
+      normalize_and_resample();
+      steps_since_update = 0;
+      moved_since_update = false;
+    }
+  }
+
+  update_estimate();
+
+  // The inner odometry's velocity is in its own frame, which is rotated from
+  // the field by however much the heading has been corrected
+  double rotation =
+      estimate.theta.convert(radian) - state.pos.theta.convert(radian);
+  double c = std::cos(rotation);
+  double s = std::sin(rotation);
+  Velocity vel{c * state.vel.xv - s * state.vel.yv,
+               s * state.vel.xv + c * state.vel.yv, state.vel.angular};
+
+  published_state.write({estimate, vel});
+}
+
+float RangeCorrectedOdometry::uniform() {
+  // xorshift32. Only needs to be fast, not good.
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return (rng_state >> 8) * (1.0f / 16777216.0f);
+}
+
+float RangeCorrectedOdometry::gaussian() {
+  // Sum of four uniforms, scaled to unit variance. Close enough to normal for
+  // motion noise, and much cheaper than Box-Muller.
+  return (uniform() + uniform() + uniform() + uniform() - 2.0f) * 1.7320508f;
+}
+
+void RangeCorrectedOdometry::scatter(Pose pos) {
+  float x = pos.x.convert(meter);
+  float y = pos.y.convert(meter);
+  float theta = pos.theta.convert(radian);
+  float spread = config.initial_spread.convert(meter);
+  float heading_spread = config.initial_heading_spread.convert(radian);
+  float weight = 1.0f / config.particles;
+
+  for (size_t i = 0; i < config.particles; i++) {
+    xs[i] = x + spread * gaussian();
+    ys[i] = y + spread * gaussian();
+    thetas[i] = theta + heading_spread * gaussian();
+    weights[i] = weight;
+  }
+  update_trig();
+
+  steps_since_update = 0;
+  moved_since_update = false;
+  update_estimate();
+  published_state.write({estimate, {0_mps, 0_mps, 0_deg / second}});
+}
+
+void RangeCorrectedOdometry::predict(Pose motion) {
+  float dx = motion.x.convert(meter);
+  float dy = motion.y.convert(meter);
+  float dtheta = motion.theta.convert(radian);
+  if (dx == 0 && dy == 0 && dtheta == 0)
+    return;
+
+  float translation_sigma = config.translation_noise * std::hypot(dx, dy);
+  float rotation_sigma = config.rotation_noise * std::abs(dtheta);
+
+  for (size_t i = 0; i < config.particles; i++) {
+    float local_x = dx + translation_sigma * gaussian();
+    float local_y = dy + translation_sigma * gaussian();
+    float c = cos_thetas[i];
+    float s = sin_thetas[i];
+    xs[i] += c * local_x - s * local_y;
+    ys[i] += s * local_x + c * local_y;
+    float theta = thetas[i] + dtheta + rotation_sigma * gaussian();
+    thetas[i] = theta - std::floor((theta + float(M_PI)) / float(2 * M_PI)) *
+                            float(2 * M_PI);
+  }
+  update_trig();
+
+  moved_since_update = true;
+}
+
+void RangeCorrectedOdometry::weigh(Pose offset, QLength range) {
+  const size_t n = config.particles;
+  const float mount_x = offset.x.convert(meter);
+  const float mount_y = offset.y.convert(meter);
+  const float beam_c = std::cos(offset.theta.convert(radian));
+  const float beam_s = std::sin(offset.theta.convert(radian));
+
+  float* __restrict ray_x = ray_xs.data();
+  float* __restrict ray_y = ray_ys.data();
+  float* __restrict ray_dx = ray_dxs.data();
+  float* __restrict ray_dy = ray_dys.data();
+  float* __restrict expected = ranges.data();
+  float* __restrict weight = weights.data();
+  const float* __restrict x = xs.data();
+  const float* __restrict y = ys.data();
+  const float* __restrict c = cos_thetas.data();
+  const float* __restrict s = sin_thetas.data();
+
+  // Where each particle puts the sensor, and which way it points
+  for (size_t i = 0; i < n; i++) {
+    ray_x[i] = x[i] + c[i] * mount_x - s[i] * mount_y;
+    ray_y[i] = y[i] + s[i] * mount_x + c[i] * mount_y;
+    ray_dx[i] = c[i] * beam_c - s[i] * beam_s;
+    ray_dy[i] = s[i] * beam_c + c[i] * beam_s;
+    expected[i] = NO_HIT;
+  }
+
+  // Distance along each ray to the nearest wall. Solves
+  // ray + t * dir = start + u * (end - start) for every particle at once.
+  for (const WallSegment& wall : field.walls) {
+    const float start_x = wall.start.x.convert(meter);
+    const float start_y = wall.start.y.convert(meter);
+    const float edge_x = wall.end.x.convert(meter) - start_x;
+    const float edge_y = wall.end.y.convert(meter) - start_y;
+
+    for (size_t i = 0; i < n; i++) {
+      float to_x = start_x - ray_x[i];
+      float to_y = start_y - ray_y[i];
+      float denominator = ray_dx[i] * edge_y - ray_dy[i] * edge_x;
+      float t = (to_x * edge_y - to_y * edge_x) / denominator;
+      float u = (to_x * ray_dy[i] - to_y * ray_dx[i]) / denominator;
+      bool hit = denominator != 0 && t > 0 && u >= 0 && u <= 1;
+      expected[i] = hit && t < expected[i] ? t : expected[i];
+    }
+  }
+
+  // The V5 distance sensor is accurate to about 15 mm up to 200 mm, and about
+  // 5% beyond that. Readings which miss are spread over the rest of the range.
+  const float measured = range.convert(meter);
+  const float sigma = std::max(0.015f, 0.05f * measured);
+  const float scale = -0.5f / (sigma * sigma);
+  const float hit_weight = 1.0f - config.outlier_probability;
+  const float outlier_weight = config.outlier_probability;
+
+  for (size_t i = 0; i < n; i++) {
+    float error = expected[i] - measured;
+    weight[i] *= hit_weight * std::exp(error * error * scale) + outlier_weight;
+  }
+}
+
+void RangeCorrectedOdometry::update_trig() {
+  for (size_t i = 0; i < config.particles; i++) {
+    cos_thetas[i] = std::cos(thetas[i]);
+    sin_thetas[i] = std::sin(thetas[i]);
+  }
+}
+
+void RangeCorrectedOdometry::normalize_and_resample() {
+  const size_t n = config.particles;
+
+  float sum = 0;
+  for (size_t i = 0; i < n; i++)
+    sum += weights[i];
+
+  // Every particle disagrees with the sensors. Keep them all rather than
+  // amplify rounding noise, and let the next readings decide.
+  if (!(sum > 1e-30f) || !std::isfinite(sum)) {
+    std::fill(weights.begin(), weights.end(), 1.0f / n);
+    return;
+  }
+
+  float squares = 0;
+  for (size_t i = 0; i < n; i++) {
+    weights[i] /= sum;
+    squares += weights[i] * weights[i];
+  }
+
+  // Effective number of particles is 1 / sum(w^2)
+  if (1.0f / squares >= config.resample_threshold * n)
+    return;
+
+  // Systematic resampling, which keeps the particle order and needs only one
+  // random number
+  float interval = 1.0f / n;
+  float pointer = uniform() * interval;
+  float cumulative = weights[0];
+  size_t j = 0;
+  for (size_t i = 0; i < n; i++) {
+    while (pointer > cumulative && j < n - 1)
+      cumulative += weights[++j];
+    resampled_xs[i] = xs[j];
+    resampled_ys[i] = ys[j];
+    resampled_thetas[i] = thetas[j];
+    pointer += interval;
+  }
+
+  xs.swap(resampled_xs);
+  ys.swap(resampled_ys);
+  thetas.swap(resampled_thetas);
+  std::fill(weights.begin(), weights.end(), interval);
+  update_trig();
+}
+
+void RangeCorrectedOdometry::update_estimate() {
+  float sum = 0, x = 0, y = 0, c = 0, s = 0;
+  for (size_t i = 0; i < config.particles; i++) {
+    sum += weights[i];
+    x += weights[i] * xs[i];
+    y += weights[i] * ys[i];
+    c += weights[i] * cos_thetas[i];
+    s += weights[i] * sin_thetas[i];
+  }
+  if (!(sum > 0))
+    return;
+
+  estimate = {x / sum * meter, y / sum * meter, std::atan2(s, c) * radian};
+}
+}  // namespace rev
@@ -0,0 +1,133 @@
+#include "rev/api/alg/odometry/tracking_wheel_calibration.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "pros/error.h"
+
+namespace rev {
+
+namespace {
+// Wraps an angle in degrees into [-180, 180)
+double wrap_degrees(double angle) {
+  return angle - std::floor((angle + 180.0) / 360.0) * 360.0;
+}
+
+// Root mean square of the residuals of the fit y = k * a + o * b
+QLength residual(double aa, double ab, double bb, double ay, double by,
+                 double yy, size_t n, double k, double o) {
+  if (n == 0)
+    return 0_in;
+  double squares = yy - 2 * (k * ay + o * by) + k * k * aa +
+                   2 * k * o * ab + o * o * bb;
+  return std::sqrt(std::max(squares, 0.0) / n) * meter;
+}
+}  // namespace
+
+void TrackingWheelCalibrator::WheelSums::add(double a,
+                                             double b,
+                                             double y,
+                                             bool line) {
+  aa += a * a;
+  ab += a * b;
+  bb += b * b;
+  ay += a * y;
+  by += b * y;
+  yy += y * y;
+  segments++;
+  if (line)
+    lines++;
+}
+
+void TrackingWheelCalibrator::begin_segment(CalibrationMotion imotion,
+                                            QLength idistance) {
+  motion = imotion;
+  distance = idistance;
+  recording = true;
+  has_sample = false;
+  turn = 0;
+}
+
+void TrackingWheelCalibrator::add_sample(const OdometrySample& sample) {
+  if (!recording || sample.longitudinal == PROS_ERR ||
+      sample.lateral == PROS_ERR || sample.heading == PROS_ERR_F)
+    return;
+
+  if (!has_sample) {
+    first = sample;
+    has_sample = true;
+  } else {
+    // Spins go round many times, so the heading is unwrapped as it goes
+    turn += wrap_degrees(sample.heading - last.heading);
+  }
+  last = sample;
+}
+
+void TrackingWheelCalibrator::end_segment() {
+  if (!recording)
+    return;
+  recording = false;
+  if (!has_sample)
+    return;
+
+  double longitude_delta = (last.longitudinal - first.longitudinal) / 100.0;
+  double latitude_delta = (last.lateral - first.lateral) / 100.0;
+  double turn_radians = turn * M_PI / 180.0;
+  double travel = distance.convert(meter);
+
+  longitudinal.add(longitude_delta, turn_radians,
+                   motion == CalibrationMotion::FORWARD ? travel : 0,
+                   motion == CalibrationMotion::FORWARD);
+  lateral.add(latitude_delta, turn_radians,
+              motion == CalibrationMotion::SIDEWAYS ? travel : 0,
+              motion == CalibrationMotion::SIDEWAYS);
+}
+
+void TrackingWheelCalibrator::reset() {
+  longitudinal = WheelSums();
+  lateral = WheelSums();
+  recording = false;
+}
+
+bool TrackingWheelCalibrator::solve(WheelCalibration& result) {
+  const WheelSums& lon = longitudinal;
+  const WheelSums& lat = lateral;
+
+  // Both unknowns need a spin and a line to separate them
+  if (lon.lines == 0 || lon.segments == lon.lines)
+    return false;
+
+  double det = lon.aa * lon.bb - lon.ab * lon.ab;
+  if (!(std::abs(det) > 1e-12 * lon.aa * lon.bb))
+    return false;
+
+  // Longitudinal wheel meters per degree and offset
+  double lon_k = (lon.ay * lon.bb - lon.by * lon.ab) / det;
+  double lon_o = (lon.aa * lon.by - lon.ab * lon.ay) / det;
+
+  double lat_k = lon_k;
+  double lat_o = 0;
+  result.lateral_diameter_fitted = false;
+  double lat_det = lat.aa * lat.bb - lat.ab * lat.ab;
+  if (lat.lines > 0 && lat.segments > lat.lines &&
+      std::abs(lat_det) > 1e-12 * lat.aa * lat.bb) {
+    lat_k = (lat.ay * lat.bb - lat.by * lat.ab) / lat_det;
+    lat_o = (lat.aa * lat.by - lat.ab * lat.ay) / lat_det;
+    result.lateral_diameter_fitted = true;
+  } else if (lat.bb > 0) {
+    // Same wheel as the longitudinal one, so only the offset is fitted
+    lat_o = (lat.by - lat_k * lat.ab) / lat.bb;
+  }
+
+  result.longitudinal_wheel_diameter = lon_k * 360.0 / M_PI * meter;
+  result.lateral_wheel_diameter = lat_k * 360.0 / M_PI * meter;
+  result.longitudinal_wheel_offset = lon_o * meter;
+  result.lateral_wheel_offset = lat_o * meter;
+  result.longitudinal_residual = residual(lon.aa, lon.ab, lon.bb, lon.ay,
+                                          lon.by, lon.yy, lon.segments,
+                                          lon_k, lon_o);
+  result.lateral_residual = residual(lat.aa, lat.ab, lat.bb, lat.ay, lat.by,
+                                     lat.yy, lat.segments, lat_k, lat_o);
+  return true;
+}
+}  // namespace rev
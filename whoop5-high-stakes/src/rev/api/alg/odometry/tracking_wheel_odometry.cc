@@ -0,0 +1,373 @@
+#include "rev/api/alg/odometry/tracking_wheel_odometry.hh"
+
+#include <cmath>
+#include <mutex>
+
+#include "pros/error.h"
+#include "rev/api/async/clock.hh"
+
+namespace rev {
+
+namespace {
+// If no sensor has produced a new sample for this long, in micros, the robot
+// is taken to be stationary. This is three refreshes of the shared memory
+// buffer the sensors are read from.
+constexpr uint64_t STALE_SAMPLE_TIME = 30000;
+
+// Wraps an angle in degrees into [-180, 180)
+double wrap_degrees(double angle) {
+  return angle - std::floor((angle + 180.0) / 360.0) * 360.0;
+}
+}  // namespace
+
+TrackingWheelOdometry::TrackingWheelOdometry(
+    QLength ilongitudinal_wheel_diameter,
+    QLength ilateral_wheel_diameter,
+    QLength ilongitudinal_wheel_offset,
+    QLength ilateral_wheel_offset)
+    : longitudinal_wheel_diameter(ilongitudinal_wheel_diameter),
+      lateral_wheel_diameter(ilateral_wheel_diameter),
+      longitudinal_wheel_offset(ilongitudinal_wheel_offset),
+      lateral_wheel_offset(ilateral_wheel_offset) {}
+
+OdometryState TrackingWheelOdometry::get_state() {
+  return published_state.read();
+}
+
+void TrackingWheelOdometry::set_position(Position pos) {
+  std::lock_guard<rmutex> lock(current_position_mutex);
+
+  current_position.pos = pos;
+  current_position.vel = {0_mps, 0_mps, 0_deg / second};
+  reset_velocity_estimators();
+  heading_ticks_init = heading_ticks_last - pos.theta.convert(degree);
+  heading_fusion.clear_variance();
+
+  published_state.write(current_position);
+  published_heading_variance.write(0.0);
+  history.clear();
+  history.record(get_clock().micros(), current_position);
+}
+
+void TrackingWheelOdometry::set_integrator(OdometryIntegrator iintegrator) {
+  std::lock_guard<rmutex> lock(current_position_mutex);
+  integrator = iintegrator;
+}
+
+void TrackingWheelOdometry::set_velocity_estimator(
+    const VelocityEstimator& prototype) {
+  std::lock_guard<rmutex> lock(current_position_mutex);
+  xv_estimator = prototype.clone();
+  yv_estimator = prototype.clone();
+  angular_estimator = prototype.clone();
+}
+
+void TrackingWheelOdometry::set_heading_fusion(
+    const HeadingFusionConfig& iconfig) {
+  std::lock_guard<rmutex> lock(current_position_mutex);
+  heading_fusion = HeadingFusion(iconfig);
+  is_initialized = false;
+}
+
+double TrackingWheelOdometry::get_heading_variance() {
+  return published_heading_variance.read();
+}
+
+void TrackingWheelOdometry::set_drive_fallback(
+    const DriveFallbackConfig& iconfig) {
+  std::lock_guard<rmutex> lock(current_position_mutex);
+  drive_fallback = iconfig;
+  has_drive_fallback = true;
+  health.drive = SensorFault::NONE;
+  published_health.write(health);
+}
+
+OdometryHealth TrackingWheelOdometry::get_health() {
+  return published_health.read();
+}
+
+void TrackingWheelOdometry::clear_faults() {
+  std::lock_guard<rmutex> lock(current_position_mutex);
+  health = OdometryHealth();
+  longitudinal_unseen = 0_in;
+  lateral_unseen = 0_in;
+  heading_unseen = 0;
+  // Start again from the next sample, since a sensor which came back may
+  // have restarted from zero. The position carries over.
+  is_initialized = false;
+  published_health.write(health);
+}
+
+void TrackingWheelOdometry::reset_velocity_estimators() {
+  xv_estimator->reset();
+  yv_estimator->reset();
+  angular_estimator->reset();
+}
+
+bool TrackingWheelOdometry::state_at(uint64_t time, OdometryState& state) {
+  return history.state_at(time, state);
+}
+
+void TrackingWheelOdometry::reset_position() {
+  set_position({0_in, 0_in, 0_deg});
+}
+
+void TrackingWheelOdometry::add_sample(const OdometrySample& sample) {
+  std::lock_guard<rmutex> lock(current_position_mutex);
+
+  // Rotation sensors report centidegrees. A sensor which fails to read is
+  // taken not to have moved.
+  double longitude_ticks = sample.longitudinal == PROS_ERR
+                               ? longitude_ticks_last
+                               : sample.longitudinal / 100.0;
+  double latitude_ticks = sample.lateral == PROS_ERR
+                              ? latitude_ticks_last
+                              : sample.lateral / 100.0;
+  double left_drive = std::isfinite(sample.left_drive) ? sample.left_drive
+                                                       : left_drive_last;
+  double right_drive = std::isfinite(sample.right_drive) ? sample.right_drive
+                                                         : right_drive_last;
+  uint64_t time = sample.time;
+
+  if (!is_initialized) {
+    heading_fusion.reset(sample);
+    double heading_ticks = heading_fusion.get_heading();
+    longitude_ticks_last = longitude_ticks;
+    latitude_ticks_last = latitude_ticks;
+    left_drive_last = left_drive;
+    right_drive_last = right_drive;
+    fused_heading_last = heading_ticks;
+    heading_ticks_last = heading_ticks;
+    for (size_t i = 0; i < sample.inertial_count(); i++)
+      inertial_headings_last[i] = sample.inertial_heading(i);
+    heading_ticks_init =
+        heading_ticks - current_position.pos.theta.convert(degree);
+    sample_time_last = time;
+    is_initialized = true;
+    return;
+  }
+
+  // How far the inertials turned by their own readings, to check the wheels
+  // against before the heading is fused
+  size_t headings = 0;
+  double raw_turn_sum = 0;
+  for (size_t i = 0; i < sample.inertial_count(); i++) {
+    double heading = sample.inertial_heading(i);
+    if (!std::isfinite(heading))
+      continue;
+    headings++;
+    raw_turn_sum += wrap_degrees(heading - inertial_headings_last[i]);
+    inertial_headings_last[i] = heading;
+  }
+  bool drive_read =
+      std::isfinite(sample.left_drive) && std::isfinite(sample.right_drive);
+
+  // A sensor which reports again after an error code is trusted again from
+  // the next sample. A count may have moved on or restarted from zero while
+  // it was out, so it starts over from this reading. The heading fusion does
+  // the same for the inertials.
+  bool longitudinal_back = health.longitudinal == SensorFault::ERROR_CODE &&
+                           sample.longitudinal != PROS_ERR;
+  bool lateral_back =
+      health.lateral == SensorFault::ERROR_CODE && sample.lateral != PROS_ERR;
+  bool inertial_back =
+      health.inertial == SensorFault::ERROR_CODE && headings > 0;
+  bool drive_back = health.drive == SensorFault::ERROR_CODE && drive_read;
+  if (longitudinal_back)
+    longitude_ticks_last = longitude_ticks;
+  if (lateral_back)
+    latitude_ticks_last = latitude_ticks;
+  if (drive_back) {
+    left_drive_last = left_drive;
+    right_drive_last = right_drive;
+  }
+
+  // Error codes fault a sensor straight away
+  if (sample.longitudinal == PROS_ERR)
+    fault(health.longitudinal, SensorFault::ERROR_CODE);
+  if (sample.lateral == PROS_ERR)
+    fault(health.lateral, SensorFault::ERROR_CODE);
+  if (headings == 0)
+    fault(health.inertial, SensorFault::ERROR_CODE);
+  if (has_drive_fallback && !drive_read)
+    fault(health.drive, SensorFault::ERROR_CODE);
+  bool drive_ok = has_drive_fallback && health.drive == SensorFault::NONE;
+
+  // Arc lengths travelled by each wheel
+  QLength longitudinal_travel = (longitude_ticks - longitude_ticks_last) /
+                                360.0 * M_PI * longitudinal_wheel_diameter;
+  QLength lateral_travel = (latitude_ticks - latitude_ticks_last) / 360.0 *
+                           M_PI * lateral_wheel_diameter;
+  longitude_ticks_last = longitude_ticks;
+  latitude_ticks_last = latitude_ticks;
+
+  // The skid-steer model of the same step, from the drive encoders
+  QLength drive_forward = 0_in;
+  double drive_turn = 0;  // Radians, clockwise
+  bool longitudinal_moved = false;
+  bool lateral_moved = false;
+  if (drive_ok) {
+    QLength drive_travel_per_degree =
+        drive_fallback.gear_ratio / 360.0 * M_PI * drive_fallback.wheel_diameter;
+    QLength left_travel = (left_drive - left_drive_last) * drive_travel_per_degree;
+    QLength right_travel =
+        (right_drive - right_drive_last) * drive_travel_per_degree;
+    drive_forward = (left_travel + right_travel) / 2;
+    drive_turn = ((left_travel - right_travel) / drive_fallback.track_width)
+                     .convert(number);
+
+    QLength longitudinal_predicted =
+        drive_forward - longitudinal_wheel_offset * drive_turn;
+    QLength lateral_predicted = -lateral_wheel_offset * drive_turn;
+    double drive_degrees = drive_turn * 180.0 / M_PI;
+
+    // A sensor only counts as stale while another shows the robot moving,
+    // since they all stop when it is pinned or pushing and only the drive
+    // wheels spin. Moving means seeing at least half of what the drive says,
+    // which a sensor jostled while the drive wheels slip doesn't.
+    auto saw_motion = [](double travel, double predicted) {
+      return predicted != 0 && travel / predicted >= 0.5;
+    };
+    longitudinal_moved = health.longitudinal == SensorFault::NONE &&
+                         saw_motion(longitudinal_travel.convert(meter),
+                                    longitudinal_predicted.convert(meter));
+    lateral_moved = health.lateral == SensorFault::NONE &&
+                    saw_motion(lateral_travel.convert(meter),
+                               lateral_predicted.convert(meter));
+    bool inertial_moved =
+        health.inertial == SensorFault::NONE && headings > 0 &&
+        saw_motion(raw_turn_sum / headings, drive_degrees);
+
+    check_wheel(health.longitudinal, longitudinal_travel,
+                longitudinal_predicted, lateral_moved || inertial_moved,
+                longitudinal_unseen);
+    check_wheel(health.lateral, lateral_travel, lateral_predicted,
+                longitudinal_moved || inertial_moved, lateral_unseen);
+  }
+  left_drive_last = left_drive;
+  right_drive_last = right_drive;
+
+  // A faulted wheel is replaced by the drive, which has no offset and can't
+  // move sideways. Without the drive there is nothing better than the wheel.
+  bool use_longitudinal = health.longitudinal == SensorFault::NONE || !drive_ok;
+  bool use_lateral = health.lateral == SensorFault::NONE || !drive_ok;
+  QLength longitudinal = use_longitudinal ? longitudinal_travel : drive_forward;
+  QLength lateral = use_lateral ? lateral_travel : 0_in;
+
+  double fused_heading =
+      heading_fusion.update(sample, longitudinal == 0_in && lateral == 0_in);
+  double inertial_turn = fused_heading - fused_heading_last;
+  fused_heading_last = fused_heading;
+
+  // Stale inertials are trusted again once they change
+  if (health.inertial == SensorFault::STALE && raw_turn_sum != 0) {
+    health.inertial = SensorFault::NONE;
+    heading_unseen = 0;
+  }
+
+  if (drive_ok && health.inertial == SensorFault::NONE) {
+    double drive_degrees = drive_turn * 180.0 / M_PI;
+    if (std::abs(inertial_turn - drive_degrees) >
+        drive_fallback.jump_turn.convert(degree)) {
+      fault(health.inertial, SensorFault::JUMP);
+    } else if (inertial_turn == 0) {
+      // Like the wheels, only while a tracking wheel shows the robot moving
+      if (longitudinal_moved || lateral_moved)
+        heading_unseen += std::abs(drive_degrees);
+      if (heading_unseen > drive_fallback.stale_turn.convert(degree))
+        fault(health.inertial, SensorFault::STALE);
+    } else {
+      heading_unseen = 0;
+    }
+  }
+
+  bool use_inertial = health.inertial == SensorFault::NONE || !drive_ok;
+  double heading_delta =
+      use_inertial ? inertial_turn : drive_turn * 180.0 / M_PI;
+  double heading_ticks = heading_ticks_last + heading_delta;
+  double heading_absolute = heading_ticks - heading_ticks_init;
+
+  // The drive stood in for the sensors which came back over this sample
+  if (longitudinal_back)
+    health.longitudinal = SensorFault::NONE;
+  if (lateral_back)
+    health.lateral = SensorFault::NONE;
+  if (inertial_back)
+    health.inertial = SensorFault::NONE;
+  if (drive_back)
+    health.drive = SensorFault::NONE;
+  published_health.write(health);
+
+  // No new sample since the last step. Keep the previous sample time so that
+  // the next velocity is measured across the whole sample interval.
+  if (longitudinal == 0_in && lateral == 0_in && heading_delta == 0) {
+    if (time - sample_time_last > STALE_SAMPLE_TIME) {
+      current_position.vel = {0_mps, 0_mps, 0_deg / second};
+      reset_velocity_estimators();
+      published_state.write(current_position);
+      history.record(time, current_position);
+    }
+    return;
+  }
+
+  double dt = (time - sample_time_last) * 0.000001;
+
+  heading_ticks_last = heading_ticks;
+  sample_time_last = time;
+
+  OdometryDelta delta{longitudinal, lateral,
+                      wrap_degrees(heading_delta) * degree,
+                      heading_absolute * degree};
+  PointVector displacement = integrate_odometry(
+      integrator, delta,
+      use_longitudinal ? longitudinal_wheel_offset : 0_in,
+      use_lateral ? lateral_wheel_offset : 0_in);
+
+  current_position.pos.x += displacement.x;
+  current_position.pos.y += displacement.y;
+  current_position.pos.theta = wrap_degrees(heading_absolute) * degree;
+
+  current_position.vel.xv =
+      xv_estimator->update(displacement.x.convert(meter), dt) * mps;
+  current_position.vel.yv =
+      yv_estimator->update(displacement.y.convert(meter), dt) * mps;
+  current_position.vel.angular =
+      angular_estimator->update(delta.heading_delta.convert(radian), dt) *
+      radps;
+
+  published_state.write(current_position);
+  published_heading_variance.write(heading_fusion.get_variance());
+  history.record(time, current_position);
+}
+
+void TrackingWheelOdometry::check_wheel(SensorFault& wheel,
+                                        QLength travel,
+                                        QLength predicted,
+                                        bool others_moved,
+                                        QLength& unseen) {
+  if (wheel == SensorFault::STALE && travel != 0_in) {
+    wheel = SensorFault::NONE;
+    unseen = 0_in;
+  }
+  if (wheel != SensorFault::NONE)
+    return;
+
+  if (abs(travel - predicted) > drive_fallback.jump_distance) {
+    fault(wheel, SensorFault::JUMP);
+  } else if (travel == 0_in) {
+    // The wheel may just not have refreshed yet, so it takes a good distance
+    // of not changing to count as stale
+    if (others_moved)
+      unseen += abs(predicted);
+    if (unseen > drive_fallback.stale_distance)
+      fault(wheel, SensorFault::STALE);
+  } else {
+    unseen = 0_in;
+  }
+}
+
+void TrackingWheelOdometry::fault(SensorFault& sensor, SensorFault reason) {
+  if (sensor == SensorFault::NONE)
+    sensor = reason;
+}
+}  // namespace rev
@@ -0,0 +1,139 @@
+#include "rev/api/alg/odometry/two_rotation_inertial_odometry.hh"
+
+#include <utility>
+
+#include "pros/error.h"
+#include "rev/api/async/clock.hh"
+
+namespace rev {
+
+namespace {
+// Longest a repeated reading goes uncaptured, in micros
+constexpr uint64_t CAPTURE_REPEAT_TIME = 10000;
+
+// Average position of the motors in a group which can be read, in degrees
+double average_position(pros::MotorGroup& group) {
+  double sum = 0;
+  int count = 0;
+  for (int i = 0; i < group.size(); i++) {
+    double position = group[i].get_position();
+    if (position != PROS_ERR_F) {
+      sum += position;
+      count++;
+    }
+  }
+  return count > 0 ? sum / count : PROS_ERR_F;
+}
+}  // namespace
+
+TwoRotationInertialOdometry::TwoRotationInertialOdometry(
+    pros::Rotation ilongitudinal_sensor,
+    pros::Rotation ilateral_sensor,
+    pros::Imu iinertial,
+    QLength ilongitudinal_wheel_diameter,
+    QLength ilateral_wheel_diameter,
+    QLength ilongitudinal_wheel_offset,
+    QLength ilateral_wheel_offset)
+    : TwoRotationInertialOdometry(ilongitudinal_sensor,
+                                  ilateral_sensor,
+                                  std::vector<pros::Imu>{iinertial},
+                                  ilongitudinal_wheel_diameter,
+                                  ilateral_wheel_diameter,
+                                  ilongitudinal_wheel_offset,
+                                  ilateral_wheel_offset) {}
+
+TwoRotationInertialOdometry::TwoRotationInertialOdometry(
+    pros::Rotation ilongitudinal_sensor,
+    pros::Rotation ilateral_sensor,
+    std::vector<pros::Imu> iinertials,
+    QLength ilongitudinal_wheel_diameter,
+    QLength ilateral_wheel_diameter,
+    QLength ilongitudinal_wheel_offset,
+    QLength ilateral_wheel_offset)
+    : TrackingWheelOdometry(ilongitudinal_wheel_diameter,
+                            ilateral_wheel_diameter,
+                            ilongitudinal_wheel_offset,
+                            ilateral_wheel_offset),
+      longitudinal_sensor(ilongitudinal_sensor),
+      lateral_sensor(ilateral_sensor),
+      inertials(std::move(iinertials)) {
+  while (inertials.size() > MAX_INERTIALS)
+    inertials.pop_back();
+}
+
+void TwoRotationInertialOdometry::set_data_rate(uint32_t rate) {
+  longitudinal_sensor.set_data_rate(rate);
+  lateral_sensor.set_data_rate(rate);
+  for (pros::Imu& inertial : inertials)
+    inertial.set_data_rate(rate);
+}
+
+void TwoRotationInertialOdometry::set_capture(
+    std::shared_ptr<OdometryLogRing> iring) {
+  capture = iring;
+}
+
+void TwoRotationInertialOdometry::set_drive_encoders(
+    pros::MotorGroup& ileft,
+    pros::MotorGroup& iright,
+    const DriveFallbackConfig& iconfig) {
+  ileft.set_encoder_units(pros::E_MOTOR_ENCODER_DEGREES);
+  iright.set_encoder_units(pros::E_MOTOR_ENCODER_DEGREES);
+  left_drive = &ileft;
+  right_drive = &iright;
+  set_drive_fallback(iconfig);
+}
+
+double TwoRotationInertialOdometry::read_heading(size_t i) {
+  // An IMU which was replugged recalibrates, and reads zero meanwhile
+  if (inertials[i].is_calibrating())
+    return PROS_ERR_F;
+  return inertials[i].get_heading();
+}
+
+OdometrySample TwoRotationInertialOdometry::read_sample() {
+  OdometrySample sample{get_clock().micros(),
+                        longitudinal_sensor.get_position(),
+                        lateral_sensor.get_position(), read_heading(0)};
+  sample.extra_inertials = inertials.size() - 1;
+  for (size_t i = 1; i < inertials.size(); i++)
+    sample.extra_headings[i - 1] = read_heading(i);
+  if (left_drive && right_drive) {
+    sample.left_drive = average_position(*left_drive);
+    sample.right_drive = average_position(*right_drive);
+  }
+  return sample;
+}
+
+void TwoRotationInertialOdometry::step() {
+  OdometrySample sample = read_sample();
+
+  // Wait for an IMU to finish its startup calibration. Any still calibrating
+  // are picked up by the heading fusion once they finish, and after startup a
+  // sensor failing is left to the health checks.
+  bool any_heading = false;
+  bool repeated_headings = true;
+  for (size_t i = 0; i < sample.inertial_count(); i++) {
+    any_heading |= sample.inertial_heading(i) != PROS_ERR_F;
+    repeated_headings &=
+        sample.inertial_heading(i) == captured_last.inertial_heading(i);
+  }
+  if (!started && !any_heading)
+    return;
+  started = true;
+
+  if (capture) {
+    bool repeated = sample.longitudinal == captured_last.longitudinal &&
+                    sample.lateral == captured_last.lateral &&
+                    sample.left_drive == captured_last.left_drive &&
+                    sample.right_drive == captured_last.right_drive &&
+                    repeated_headings;
+    if (!repeated || sample.time - captured_last.time >= CAPTURE_REPEAT_TIME) {
+      capture->push(sample);
+      captured_last = sample;
+    }
+  }
+
+  add_sample(sample);
+}
+}  // namespace rev
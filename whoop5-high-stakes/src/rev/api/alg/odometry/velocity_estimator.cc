@@ -0,0 +1,137 @@
+#include "rev/api/alg/odometry/velocity_estimator.hh"
+
+#include <algorithm>
+
+namespace rev {
+
+double RawVelocity::update(double displacement, double dt) {
+  return dt > 0 ? displacement / dt : 0.0;
+}
+
+void RawVelocity::reset() {}
+
+std::unique_ptr<VelocityEstimator> RawVelocity::clone() const {
+  return std::make_unique<RawVelocity>();
+}
+
+EmaVelocity::EmaVelocity(double ialpha)
+    : alpha(std::min(std::max(ialpha, 0.0), 1.0)) {}
+
+double EmaVelocity::update(double displacement, double dt) {
+  if (dt <= 0)
+    return velocity;
+
+  double raw = displacement / dt;
+  if (!primed) {
+    velocity = raw;
+    primed = true;
+  } else {
+    velocity += alpha * (raw - velocity);
+  }
+  return velocity;
+}
+
+void EmaVelocity::reset() {
+  velocity = 0.0;
+  primed = false;
+}
+
+std::unique_ptr<VelocityEstimator> EmaVelocity::clone() const {
+  return std::make_unique<EmaVelocity>(alpha);
+}
+
+LeastSquaresVelocity::LeastSquaresVelocity(size_t iwindow)
+    : window(std::min(std::max<size_t>(iwindow, 2), MAX_WINDOW)) {}
+
+double LeastSquaresVelocity::update(double displacement, double dt) {
+  position += displacement;
+  time += dt;
+
+  positions[next] = position;
+  times[next] = time;
+  next = (next + 1) % window;
+  count = std::min(count + 1, window);
+
+  if (count < 2)
+    return dt > 0 ? displacement / dt : 0.0;
+
+  double time_mean = 0.0;
+  double position_mean = 0.0;
+  for (size_t i = 0; i < count; i++) {
+    time_mean += times[i];
+    position_mean += positions[i];
+  }
+  time_mean /= count;
+  position_mean /= count;
+
+  double numerator = 0.0;
+  double denominator = 0.0;
+  for (size_t i = 0; i < count; i++) {
+    double t = times[i] - time_mean;
+    numerator += t * (positions[i] - position_mean);
+    denominator += t * t;
+  }
+
+  return denominator > 0 ? numerator / denominator : 0.0;
+}
+
+void LeastSquaresVelocity::reset() {
+  count = 0;
+  next = 0;
+  position = 0.0;
+  time = 0.0;
+}
+
+std::unique_ptr<VelocityEstimator> LeastSquaresVelocity::clone() const {
+  return std::make_unique<LeastSquaresVelocity>(window);
+}
+
+KalmanVelocity::KalmanVelocity(double iprocess_noise,
+                               double imeasurement_noise)
+    : process_noise(iprocess_noise), measurement_noise(imeasurement_noise) {
+  reset();
+}
+
+double KalmanVelocity::update(double displacement, double dt) {
+  if (dt <= 0)
+    return velocity;
+
+  // Predict
+  position += velocity * dt;
+  double dt2 = dt * dt;
+  double q = process_noise;
+  p00 += dt * (2 * p01 + dt * p11) + q * dt2 * dt / 3;
+  p01 += dt * p11 + q * dt2 / 2;
+  p11 += q * dt;
+
+  // Correct against the new measurement
+  double innovation = displacement - position;
+  double s = p00 + measurement_noise;
+  double k0 = p00 / s;
+  double k1 = p01 / s;
+
+  position += k0 * innovation;
+  velocity += k1 * innovation;
+
+  p11 -= k1 * p01;
+  p01 -= k0 * p01;
+  p00 -= k0 * p00;
+
+  // Keep the position relative to the latest measurement so it never grows
+  position -= displacement;
+
+  return velocity;
+}
+
+void KalmanVelocity::reset() {
+  position = 0.0;
+  velocity = 0.0;
+  p00 = measurement_noise;
+  p01 = 0.0;
+  p11 = 1.0;
+}
+
+std::unique_ptr<VelocityEstimator> KalmanVelocity::clone() const {
+  return std::make_unique<KalmanVelocity>(process_noise, measurement_noise);
+}
+}  // namespace rev
@@ -0,0 +1,311 @@
+#include "rev/api/alg/reckless/reckless.hh"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+#include "rev/api/async/clock.hh"
+
+namespace rev {
+
+namespace {
+// Built-in strategies are called directly, and anything else through its
+// pointer. The built-in strategies are final, so the direct calls can be
+// inlined.
+template <typename T>
+T& strategy(T& value) {
+  return value;
+}
+
+template <typename T>
+T& strategy(std::shared_ptr<T>& pointer) {
+  return *pointer;
+}
+}  // namespace
+
+std::tuple<double, double> RecklessPathSegment::gen_powers(
+    const SegmentFrame& frame) {
+  return std::visit([&](auto& s) { return strategy(s).gen_powers(frame); },
+                    motion);
+}
+
+std::tuple<double, double> RecklessPathSegment::apply_correction(
+    const SegmentFrame& frame,
+    std::tuple<double, double> powers) {
+  return std::visit(
+      [&](auto& s) { return strategy(s).apply_correction(frame, powers); },
+      correction);
+}
+
+stop_state RecklessPathSegment::get_stop_state(const SegmentFrame& frame) {
+  return std::visit([&](auto& s) { return strategy(s).get_stop_state(frame); },
+                    stop);
+}
+
+double RecklessPathSegment::get_coast_power() {
+  return std::visit([](auto& s) { return strategy(s).get_coast_power(); },
+                    stop);
+}
+
+RecklessPathSegment& RecklessPathSegment::with_trigger(
+    double iprogress,
+    std::function<void()> iaction) {
+  triggers.push_back(ProgressTrigger{iprogress, std::move(iaction)});
+  return *this;
+}
+
+RecklessPath& RecklessPath::with_segment(RecklessPathSegment segment) {
+  segments.push_back(std::move(segment));
+  return *this;
+}
+
+RecklessPath& RecklessPath::with_blending(QLength iblend_distance) {
+  blend_distance = iblend_distance;
+  return *this;
+}
+
+Reckless::Reckless(std::shared_ptr<Chassis> ichassis,
+                   std::shared_ptr<Odometry> iodometry)
+    : chassis(ichassis), odometry(iodometry) {
+  done.set();
+}
+
+void Reckless::step() {
+  if (status == RecklessStatus::DONE)
+    return;
+
+  if (current_segment >= current_path.segments.size()) {
+    std::cout << "Completed motion with " << current_path.segments.size()
+              << " segments" << std::endl;
+    status = RecklessStatus::DONE;
+    partial_progress = -1.0;
+    current_segment = 0;
+    chassis->stop();
+    done.set();
+    return;
+  }
+
+  OdometryState current_state = odometry->get_state();
+  frame.update(current_state);
+  bool blending = update_next_frame(current_state);
+
+  // A blended segment hands over as soon as it reaches its drop point, so the
+  // robot keeps its speed into the next one
+  if (blending && frame.distance_remaining <= 0_m) {
+    if (!next_segment(current_state.pos))
+      return;
+    frame.update(current_state);
+    blending = update_next_frame(current_state);
+  }
+
+  // Fraction of the way from the start point to the target point, projected
+  // onto the segment
+  double segment_progress = frame.progress();
+  partial_progress = segment_progress + current_segment;
+  if (!fire_triggers(segment_progress))
+    return;
+
+  RecklessPathSegment& segment = current_path.segments.at(current_segment);
+
+  stop_state new_state = segment.get_stop_state(frame);
+
+  // Coasting or braking would throw away the speed being carried into the
+  // next segment, so only a timeout can end a blended segment early
+  if (blending && new_state != stop_state::EXIT)
+    new_state = stop_state::GO;
+
+  if (new_state != last_stop_state) {
+    std::cout << "State change occured to "
+              << (new_state == stop_state::GO      ? "GO"
+                  : new_state == stop_state::COAST ? "COAST"
+                                                   : "BRAKE")
+              << std::endl;
+    last_stop_state = new_state;
+  }
+
+  // Powers sent to the chassis this step, for telemetry
+  double left_power = 0.0;
+  double right_power = 0.0;
+  uint32_t segment_index = current_segment;
+
+  switch (new_state) {
+    case stop_state::GO: {
+      auto powers = segment.gen_powers(frame);
+
+      // How far through the hand over to the next segment, in [0, 1]
+      double blend =
+          blending ? std::clamp(1.0 - (frame.distance_remaining /
+                                       current_path.blend_distance)
+                                          .get_value(),
+                                0.0, 1.0)
+                   : 0.0;
+
+      std::tuple<double, double> corrected;
+      if (blend > 0.0) {
+        RecklessPathSegment& next =
+            current_path.segments.at(current_segment + 1);
+        auto next_powers = next.gen_powers(next_frame);
+        powers = std::make_tuple(
+            std::get<0>(powers) +
+                (std::get<0>(next_powers) - std::get<0>(powers)) * blend,
+            std::get<1>(powers) +
+                (std::get<1>(next_powers) - std::get<1>(powers)) * blend);
+
+        // Aim between the two targets, so the robot turns into the next
+        // segment gradually rather than all at once at the hand over
+        Position aim = segment.target_point;
+        aim.x += (next.target_point.x - segment.target_point.x) * blend;
+        aim.y += (next.target_point.y - segment.target_point.y) * blend;
+        blend_frame.begin(current_state.pos, aim, 0_m);
+        blend_frame.update(current_state);
+        corrected = segment.apply_correction(blend_frame, powers);
+      } else {
+        corrected = segment.apply_correction(frame, powers);
+      }
+
+      left_power = std::get<0>(corrected);
+      right_power = std::get<1>(corrected);
+      chassis->drive_tank(left_power, right_power);
+      brake_time = -1;
+      break;
+    }
+    case stop_state::COAST: {
+      double power = segment.get_coast_power();
+
+      // Coast in whichever direction the segment runs relative to the facing
+      // direction at its start
+      if (frame.reversed)
+        power = -power;
+
+      left_power = right_power = power;
+      chassis->drive_tank(power, power);
+      brake_time = -1;
+      break;
+    }
+    case stop_state::BRAKE:
+      if (brake_time == -1) {
+        chassis->set_brake_harsh();
+        chassis->stop();
+        brake_time = get_clock().millis();
+      } else if (get_clock().millis() > brake_time + 250) {
+        chassis->set_brake_coast();
+        brake_time = -1;
+        if (!next_segment(current_state.pos))
+          return;
+      }
+      break;
+    case stop_state::EXIT:
+      chassis->set_brake_coast();
+      chassis->stop();
+      brake_time = -1;
+      if (!next_segment(current_state.pos))
+        return;
+      break;
+  }
+
+  if (telemetry)
+    telemetry->push(TelemetryRecord{get_clock().millis(), current_state.pos,
+                                    current_state.vel, left_power, right_power,
+                                    new_state, segment_index});
+}
+
+void Reckless::await() {
+  done.wait();
+}
+
+bool Reckless::await_for(QTime timeout) {
+  return done.wait_for(timeout);
+}
+
+void Reckless::go(const RecklessPath& path) {
+  if (status != RecklessStatus::DONE)
+    breakout();
+
+  current_segment = 0;
+  current_path = path;
+  paths_started++;
+  start_segment(odometry->get_state().pos);
+
+  done.clear();
+  status = RecklessStatus::ACTIVE;
+
+  std::cout << "Started motion with " << current_path.segments.size()
+            << " segments" << std::endl;
+}
+
+RecklessStatus Reckless::get_status() {
+  return status;
+}
+
+double Reckless::progress() {
+  return partial_progress;
+}
+
+bool Reckless::is_completed() {
+  return status == RecklessStatus::DONE;
+}
+
+void Reckless::breakout() {
+  paths_started++;
+  status = RecklessStatus::DONE;
+  done.set();
+}
+
+void Reckless::start_segment(const Position& start) {
+  if (current_segment >= current_path.segments.size())
+    return;
+
+  RecklessPathSegment& segment = current_path.segments.at(current_segment);
+  segment.start_point = start;
+  frame.begin(segment.start_point, segment.target_point, segment.drop_early);
+}
+
+bool Reckless::next_segment(const Position& pos) {
+  // Triggers past where the segment stopped short still run, once
+  if (!fire_triggers(std::numeric_limits<double>::infinity()))
+    return false;
+  current_segment++;
+  start_segment(pos);
+  return true;
+}
+
+bool Reckless::fire_triggers(double segment_progress) {
+  // An action may call go() or breakout(), which replaces the path being
+  // looked through, so the due actions are moved out and only run once the
+  // triggers have all been marked. Each runs once per copy of the path, so
+  // moving doesn't lose it.
+  StaticVector<std::function<void()>, MAX_SEGMENT_TRIGGERS> due;
+  for (ProgressTrigger& trigger :
+       current_path.segments.at(current_segment).triggers) {
+    if (!trigger.fired && segment_progress >= trigger.progress) {
+      trigger.fired = true;
+      if (trigger.action)
+        due.push_back(std::move(trigger.action));
+    }
+  }
+
+  uint32_t path = paths_started;
+  for (std::function<void()>& action : due)
+    action();
+  return paths_started == path;
+}
+
+bool Reckless::update_next_frame(const OdometryState& state) {
+  if (current_path.blend_distance <= 0_m ||
+      current_segment + 1 >= current_path.segments.size())
+    return false;
+
+  const RecklessPathSegment& next =
+      current_path.segments.at(current_segment + 1);
+  next_frame.begin(state.pos, next.target_point, next.drop_early);
+  next_frame.update(state);
+
+  // Reversing direction needs a stop, so only blend into a segment which
+  // carries on the same way
+  return next_frame.reversed == frame.reversed;
+}
+
+void Reckless::set_telemetry(std::shared_ptr<TelemetryRing> iring) {
+  telemetry = iring;
+}
+}  // namespace rev
@@ -0,0 +1,281 @@
+#include "rev/api/alg/sequence/actions.hh"
+
+#include "rev/api/async/clock.hh"
+
+namespace rev {
+
+namespace {
+
+class DrivePathAction : public Action {
+ public:
+  DrivePathAction(std::shared_ptr<Reckless> ireckless,
+                  const RecklessPath& ipath)
+      : reckless(ireckless), path(ipath) {}
+
+  void start() override { reckless->go(path); }
+
+  ActionStatus update() override {
+    return reckless->is_completed() ? ActionStatus::DONE
+                                    : ActionStatus::RUNNING;
+  }
+
+  void cancel() override { reckless->breakout(); }
+
+ private:
+  std::shared_ptr<Reckless> reckless;
+  RecklessPath path;
+};
+
+class TurnToAction : public Action {
+ public:
+  TurnToAction(std::shared_ptr<CampbellTurn> iturn,
+               double imax_power,
+               QAngle iangle)
+      : turn(iturn), max_power(imax_power), angle(iangle) {}
+
+  void start() override { turn->turn_to_target_absolute(max_power, angle); }
+
+  ActionStatus update() override {
+    return turn->is_completed() ? ActionStatus::DONE : ActionStatus::RUNNING;
+  }
+
+  void cancel() override { turn->breakout(); }
+
+ private:
+  std::shared_ptr<CampbellTurn> turn;
+  double max_power;
+  QAngle angle;
+};
+
+class FollowTrajectoryAction : public Action {
+ public:
+  FollowTrajectoryAction(std::shared_ptr<RamseteFollower> ifollower,
+                         std::vector<squiggles::ProfilePoint> itrajectory)
+      : follower(ifollower), trajectory(std::move(itrajectory)) {}
+
+  void start() override { follower->follow(trajectory); }
+
+  ActionStatus update() override {
+    return follower->is_completed() ? ActionStatus::DONE
+                                    : ActionStatus::RUNNING;
+  }
+
+  void cancel() override { follower->breakout(); }
+
+ private:
+  std::shared_ptr<RamseteFollower> follower;
+  std::vector<squiggles::ProfilePoint> trajectory;
+};
+
+class WaitUntilProgressAction : public Action {
+ public:
+  WaitUntilProgressAction(std::shared_ptr<Reckless> ireckless,
+                          double iprogress)
+      : reckless(ireckless), progress(iprogress) {}
+
+  void start() override {}
+
+  ActionStatus update() override {
+    if (reckless->is_completed() || reckless->progress() >= progress)
+      return ActionStatus::DONE;
+    return ActionStatus::RUNNING;
+  }
+
+ private:
+  std::shared_ptr<Reckless> reckless;
+  double progress;
+};
+
+class WaitTimeAction : public Action {
+ public:
+  explicit WaitTimeAction(QTime iduration)
+      : duration(iduration.convert(millisecond)) {}
+
+  void start() override { start_time = get_clock().millis(); }
+
+  ActionStatus update() override {
+    if (get_clock().millis() - start_time >= duration)
+      return ActionStatus::DONE;
+    return ActionStatus::RUNNING;
+  }
+
+ private:
+  uint32_t duration;  // In millis
+  uint32_t start_time{0};
+};
+
+class RunUntilAction : public Action {
+ public:
+  RunUntilAction(std::function<void()> ibegin,
+                 std::function<bool()> icondition,
+                 std::function<void()> iend)
+      : begin(ibegin), condition(icondition), end(iend) {}
+
+  void start() override {
+    if (begin)
+      begin();
+  }
+
+  ActionStatus update() override {
+    if (condition && !condition())
+      return ActionStatus::RUNNING;
+
+    if (end)
+      end();
+    return ActionStatus::DONE;
+  }
+
+  void cancel() override {
+    if (end)
+      end();
+  }
+
+ private:
+  std::function<void()> begin;
+  std::function<bool()> condition;
+  std::function<void()> end;
+};
+
+class SequenceAction : public Action {
+ public:
+  explicit SequenceAction(std::vector<std::shared_ptr<Action>> iactions)
+      : actions(iactions) {}
+
+  void start() override {
+    current = 0;
+    current_started = false;
+  }
+
+  ActionStatus update() override {
+    // Start the next action on the same tick the previous one finishes
+    while (current < actions.size()) {
+      if (!current_started) {
+        actions[current]->start();
+        current_started = true;
+      }
+
+      if (actions[current]->update() == ActionStatus::RUNNING)
+        return ActionStatus::RUNNING;
+
+      current++;
+      current_started = false;
+    }
+    return ActionStatus::DONE;
+  }
+
+  void cancel() override {
+    if (current < actions.size() && current_started)
+      actions[current]->cancel();
+  }
+
+ private:
+  std::vector<std::shared_ptr<Action>> actions;
+  size_t current{0};
+  bool current_started{false};
+};
+
+class ParallelAction : public Action {
+ public:
+  ParallelAction(std::vector<std::shared_ptr<Action>> iactions, bool irace)
+      : actions(iactions), running(iactions.size(), false), race(irace) {}
+
+  void start() override {
+    for (size_t i = 0; i < actions.size(); i++) {
+      actions[i]->start();
+      running[i] = true;
+    }
+  }
+
+  ActionStatus update() override {
+    bool any_done = false;
+    bool any_running = false;
+
+    for (size_t i = 0; i < actions.size(); i++) {
+      if (!running[i])
+        continue;
+
+      if (actions[i]->update() == ActionStatus::DONE) {
+        running[i] = false;
+        any_done = true;
+      } else {
+        any_running = true;
+      }
+    }
+
+    if (race && any_done && any_running) {
+      cancel();
+      return ActionStatus::DONE;
+    }
+
+    return any_running ? ActionStatus::RUNNING : ActionStatus::DONE;
+  }
+
+  void cancel() override {
+    for (size_t i = 0; i < actions.size(); i++) {
+      if (running[i]) {
+        actions[i]->cancel();
+        running[i] = false;
+      }
+    }
+  }
+
+ private:
+  std::vector<std::shared_ptr<Action>> actions;
+  std::vector<bool> running;
+  bool race;  // Finish as soon as any action does
+};
+}  // namespace
+
+std::shared_ptr<Action> drive_path(std::shared_ptr<Reckless> reckless,
+                                   const RecklessPath& path) {
+  return std::make_shared<DrivePathAction>(reckless, path);
+}
+
+std::shared_ptr<Action> turn_to(std::shared_ptr<CampbellTurn> turn,
+                                double max_power,
+                                QAngle angle) {
+  return std::make_shared<TurnToAction>(turn, max_power, angle);
+}
+
+std::shared_ptr<Action> follow_trajectory(
+    std::shared_ptr<RamseteFollower> follower,
+    std::vector<squiggles::ProfilePoint> trajectory) {
+  return std::make_shared<FollowTrajectoryAction>(follower,
+                                                  std::move(trajectory));
+}
+
+std::shared_ptr<Action> wait_until_progress(std::shared_ptr<Reckless> reckless,
+                                            double progress) {
+  return std::make_shared<WaitUntilProgressAction>(reckless, progress);
+}
+
+std::shared_ptr<Action> wait_time(QTime duration) {
+  return std::make_shared<WaitTimeAction>(duration);
+}
+
+std::shared_ptr<Action> wait_until(std::function<bool()> condition) {
+  return std::make_shared<RunUntilAction>(nullptr, condition, nullptr);
+}
+
+std::shared_ptr<Action> run(std::function<void()> function) {
+  return std::make_shared<RunUntilAction>(function, nullptr, nullptr);
+}
+
+std::shared_ptr<Action> run_until(std::function<void()> begin,
+                                  std::function<bool()> condition,
+                                  std::function<void()> end) {
+  return std::make_shared<RunUntilAction>(begin, condition, end);
+}
+
+std::shared_ptr<Action> sequence(std::vector<std::shared_ptr<Action>> actions) {
+  return std::make_shared<SequenceAction>(actions);
+}
+
+std::shared_ptr<Action> parallel(std::vector<std::shared_ptr<Action>> actions) {
+  return std::make_shared<ParallelAction>(actions, false);
+}
+
+std::shared_ptr<Action> race(std::vector<std::shared_ptr<Action>> actions) {
+  return std::make_shared<ParallelAction>(actions, true);
+}
+}  // namespace rev
@@ -0,0 +1,59 @@
+#include "rev/api/alg/sequence/sequencer.hh"
+
+#include <mutex>
+
+namespace rev {
+
+Sequencer::Sequencer() {
+  done.set();
+}
+
+void Sequencer::run(std::shared_ptr<Action> iroutine) {
+  std::lock_guard<rmutex> lock(mutex);
+
+  if (routine && started)
+    routine->cancel();
+
+  routine = iroutine;
+  started = false;
+  if (routine)
+    done.clear();
+  else
+    done.set();
+}
+
+void Sequencer::cancel() {
+  run(nullptr);
+}
+
+bool Sequencer::is_completed() {
+  std::lock_guard<rmutex> lock(mutex);
+  return !routine;
+}
+
+void Sequencer::step() {
+  std::lock_guard<rmutex> lock(mutex);
+
+  if (!routine)
+    return;
+
+  if (!started) {
+    routine->start();
+    started = true;
+  }
+
+  if (routine->update() == ActionStatus::DONE) {
+    routine = nullptr;
+    started = false;
+    done.set();
+  }
+}
+
+void Sequencer::await() {
+  done.wait();
+}
+
+bool Sequencer::await_for(QTime timeout) {
+  return done.wait_for(timeout);
+}
+}  // namespace rev
@@ -0,0 +1,175 @@
+#include "rev/api/alg/trajectory/ramsete_follower.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "rev/api/async/clock.hh"
+#include "rev/util/mathutil.hh"
+
+namespace rev {
+
+namespace {
+// Wraps an angle into [-180deg, 180deg)
+QAngle constrain_angle(QAngle angle) {
+  return angle - 360_deg * floor((angle + 180_deg) / 360_deg);
+}
+
+// sin(x) / x, which goes to 1 at 0
+double sinc(double x) {
+  if (std::abs(x) < 1e-6)
+    return 1.0 - x * x / 6.0;
+  return std::sin(x) / x;
+}
+}  // namespace
+
+RamseteFollower::RamseteFollower(std::shared_ptr<Chassis> ichassis,
+                                 std::shared_ptr<Odometry> iodometry,
+                                 RamseteConfig iconfig)
+    : chassis(ichassis), odometry(iodometry), config(iconfig) {
+  done.set();
+}
+
+void RamseteFollower::follow(
+    const std::vector<squiggles::ProfilePoint>& itrajectory) {
+  if (active)
+    breakout();
+
+  trajectory.clear();
+  trajectory.reserve(itrajectory.size());
+  for (const squiggles::ProfilePoint& point : itrajectory) {
+    const squiggles::ControlVector& vector = point.vector;
+    trajectory.push_back(Sample{
+        point.time * second,
+        {vector.pose.x * meter, vector.pose.y * meter,
+         vector.pose.yaw * radian},
+        (std::isnan(vector.vel) ? 0.0 : vector.vel) * mps,
+        vector.accel * mps2,
+        point.curvature});
+  }
+
+  if (trajectory.empty())
+    return;
+
+  cursor = 0;
+  start_time = -1;
+  partial_progress = 0.0;
+  done.clear();
+  active = true;
+}
+
+RamseteFollower::Sample RamseteFollower::sample(QTime time) {
+  while (cursor + 2 < trajectory.size() &&
+         trajectory[cursor + 1].time <= time)
+    cursor++;
+
+  const Sample& from = trajectory[cursor];
+  if (cursor + 1 >= trajectory.size() || time <= from.time)
+    return from;
+
+  const Sample& to = trajectory[cursor + 1];
+  if (time >= to.time)
+    return to;
+
+  double t = ((time - from.time) / (to.time - from.time)).get_value();
+  Sample result = from;
+  result.time = time;
+  result.pos.x += (to.pos.x - from.pos.x) * t;
+  result.pos.y += (to.pos.y - from.pos.y) * t;
+  result.pos.theta += constrain_angle(to.pos.theta - from.pos.theta) * t;
+  result.v += (to.v - from.v) * t;
+  result.a += (to.a - from.a) * t;
+  result.curvature += (to.curvature - from.curvature) * t;
+  return result;
+}
+
+void RamseteFollower::step() {
+  if (!active)
+    return;
+
+  long long now = get_clock().millis();
+  if (start_time == -1)
+    start_time = now;
+
+  QTime elapsed = (now - start_time) * millisecond;
+  QTime duration = trajectory.back().time;
+  if (elapsed > duration) {
+    active = false;
+    partial_progress = -1.0;
+    chassis->stop();
+    done.set();
+    return;
+  }
+  if (duration > 0_s)
+    partial_progress = (elapsed / duration).get_value();
+
+  Sample reference = sample(elapsed);
+  OdometryState state = odometry->get_state();
+
+  // Error to the reference, in the robot's frame
+  double c = cos(state.pos.theta).get_value();
+  double s = sin(state.pos.theta).get_value();
+  double dx = (reference.pos.x - state.pos.x).convert(meter);
+  double dy = (reference.pos.y - state.pos.y).convert(meter);
+  double error_x = c * dx + s * dy;
+  double error_y = c * dy - s * dx;
+  double error_theta =
+      constrain_angle(reference.pos.theta - state.pos.theta).convert(radian);
+
+  // Rev's frame is mirrored from the usual one, with y to the right and
+  // clockwise turns positive, but mirroring both sides of the control law
+  // leaves it unchanged
+  double v_ref = reference.v.convert(mps);
+  double w_ref = v_ref * reference.curvature;
+  double gain =
+      2 * config.zeta * std::sqrt(w_ref * w_ref + config.b * v_ref * v_ref);
+  double v = v_ref * std::cos(error_theta) + gain * error_x;
+  double w = w_ref + gain * error_theta +
+             config.b * v_ref * sinc(error_theta) * error_y;
+
+  // Clockwise turns speed up the left side
+  double half_track = config.track_width.convert(meter) / 2;
+  double max_speed = config.max_speed.convert(mps);
+  double a_ref = reference.a.convert(inch / (second * second));
+  double left_accel = a_ref * (1 + reference.curvature * half_track);
+  double right_accel = a_ref * (1 - reference.curvature * half_track);
+  double left_speed = v + w * half_track;
+  double right_speed = v - w * half_track;
+
+  double left = left_speed / max_speed + config.k_a * left_accel +
+                config.k_s * sgn(left_speed);
+  double right = right_speed / max_speed + config.k_a * right_accel +
+                 config.k_s * sgn(right_speed);
+
+  // Scale both sides down together so the turn is kept
+  double max_power = std::max(std::abs(left), std::abs(right));
+  if (max_power > 1.0) {
+    left /= max_power;
+    right /= max_power;
+  }
+
+  chassis->drive_tank(left, right);
+}
+
+void RamseteFollower::await() {
+  done.wait();
+}
+
+bool RamseteFollower::await_for(QTime timeout) {
+  return done.wait_for(timeout);
+}
+
+bool RamseteFollower::is_completed() {
+  return !active;
+}
+
+void RamseteFollower::breakout() {
+  active = false;
+  partial_progress = -1.0;
+  chassis->stop();
+  done.set();
+}
+
+double RamseteFollower::progress() {
+  return partial_progress;
+}
+}  // namespace rev
@@ -0,0 +1,142 @@
+#include "rev/api/async/async_runner.hh"
+
+#include <mutex>
+
+#include "rev/api/async/rtos_time.hh"
+
+namespace rev {
+
+AsyncRunner::AsyncRunner(std::shared_ptr<AsyncRunnable> icontroller,
+                         uint32_t itdelta)
+    : AsyncRunner(icontroller, itdelta, RunnerConfig()) {}
+
+AsyncRunner::AsyncRunner(std::shared_ptr<AsyncRunnable> icontroller,
+                         uint32_t itdelta,
+                         RunnerConfig iconfig)
+    : controller(icontroller),
+      tdelta(itdelta),
+      config(iconfig),
+      budget_us(budget_to_micros(iconfig.budget)) {
+  start();
+}
+
+AsyncRunner::~AsyncRunner() {
+  stop_and_join();
+}
+
+void AsyncRunner::start() {
+  std::lock_guard<rmutex> lock(lifecycle_mutex);
+  if (thread)
+    return;
+
+  active = true;
+#ifndef OFF_ROBOT_TESTS
+  thread = new rthread(run, this, config.priority, config.stack_depth,
+                       "ReveilLib Task");
+#else
+  thread = new rthread(run, this);
+#endif
+}
+
+void AsyncRunner::pause() {
+  paused = true;
+
+  // From inside step() the lock is already held by this thread, and the step
+  // in progress is the caller, so there is nothing to wait for
+  if (rtos_current_thread() == loop_thread)
+    return;
+
+  // Wait out a step which may have started before the flag was set
+  std::lock_guard<rmutex> lock(step_mutex);
+}
+
+void AsyncRunner::resume() {
+  paused = false;
+}
+
+void AsyncRunner::stop_and_join() {
+  std::lock_guard<rmutex> lock(lifecycle_mutex);
+  if (!thread)
+    return;
+
+  active = false;
+  thread->join();
+  delete thread;
+  thread = nullptr;
+}
+
+bool AsyncRunner::is_running() {
+  return active;
+}
+
+bool AsyncRunner::is_paused() {
+  return paused;
+}
+
+RunnerStats AsyncRunner::get_stats() {
+  std::lock_guard<rmutex> lock(stats_mutex);
+  return stats.get_stats();
+}
+
+void AsyncRunner::reset_stats() {
+  std::lock_guard<rmutex> lock(stats_mutex);
+  stats.reset();
+}
+
+void AsyncRunner::run(void* context) {
+  if (context)
+    static_cast<AsyncRunner*>(context)->loop();
+}
+
+void AsyncRunner::loop() {
+  loop_thread = rtos_current_thread();
+  uint32_t deadline = rtos_millis();
+  bool was_paused = false;
+
+  while (active) {
+    if (paused) {
+      was_paused = true;
+      rtos_delay(tdelta);
+      continue;
+    }
+
+    // Restart the schedule rather than counting the pause as a missed deadline
+    if (was_paused) {
+      deadline = rtos_millis();
+      was_paused = false;
+    }
+
+    uint64_t start, finish;
+    {
+      std::lock_guard<rmutex> lock(step_mutex);
+      // pause() may have been called since the check above
+      if (paused)
+        continue;
+
+      start = rtos_micros();
+      controller->step();
+      finish = rtos_micros();
+    }
+
+    deadline += tdelta;
+    uint32_t now = rtos_millis();
+    bool missed = !rtos_reached(deadline, now);
+
+    bool over_budget = budget_us && finish - start > budget_us;
+
+    {
+      std::lock_guard<rmutex> lock(stats_mutex);
+      stats.record(start, finish, missed, over_budget);
+    }
+
+    if (over_budget && config.on_budget_exceeded)
+      config.on_budget_exceeded(*controller,
+                                (finish - start) * 0.001 * millisecond);
+
+    if (missed)
+      deadline = now;
+    else
+      rtos_delay(deadline - now);
+  }
+}
+}  // namespace rev
@@ -0,0 +1,64 @@
+#include "rev/api/async/clock.hh"
+
+#include <cmath>
+
+#include "rev/api/async/rtos_time.hh"
+
+namespace rev {
+
+namespace {
+uint64_t to_micros(QTime time) {
+  return std::llround(time.convert(millisecond) * 1000);
+}
+
+SystemClock& system_clock() {
+  static SystemClock clock;
+  return clock;
+}
+
+// The clock given to set_clock, or nullptr for the system clock. Both are
+// constant initialized, so they are safe to read during static construction.
+std::shared_ptr<Clock> installed_clock;
+Clock* current_clock = nullptr;
+}  // namespace
+
+uint32_t SystemClock::millis() {
+  return rtos_millis();
+}
+
+uint64_t SystemClock::micros() {
+  return rtos_micros();
+}
+
+void SystemClock::delay(uint32_t duration) {
+  rtos_delay(duration);
+}
+
+VirtualClock::VirtualClock(QTime start)
+    : now_us(to_micros(start)) {}
+
+uint32_t VirtualClock::millis() {
+  return now_us / 1000;
+}
+
+uint64_t VirtualClock::micros() {
+  return now_us;
+}
+
+void VirtualClock::delay(uint32_t duration) {
+  now_us += static_cast<uint64_t>(duration) * 1000;
+}
+
+void VirtualClock::advance(QTime duration) {
+  now_us += to_micros(duration);
+}
+
+Clock& get_clock() {
+  return current_clock ? *current_clock : system_clock();
+}
+
+void set_clock(std::shared_ptr<Clock> clock) {
+  current_clock = clock.get();
+  installed_clock = std::move(clock);
+}
+}  // namespace rev
@@ -0,0 +1,95 @@
+#include "rev/api/async/event.hh"
+
+#include <algorithm>
+#include <mutex>
+
+#include "rev/api/async/rtos_time.hh"
+
+namespace rev {
+
+#ifndef OFF_ROBOT_TESTS
+
+void Event::set() {
+  std::lock_guard<rmutex> lock(mutex);
+  flag = true;
+
+  for (auto task : waiters)
+    pros::c::task_notify(task);
+}
+
+void Event::wait() {
+  while (!wait_for(1_h))
+    ;
+}
+
+bool Event::wait_for(QTime timeout) {
+  pros::task_t self = pros::c::task_get_current();
+  uint32_t deadline = rtos_millis() + timeout.convert(millisecond);
+
+  {
+    std::lock_guard<rmutex> lock(mutex);
+    if (flag)
+      return true;
+    waiters.push_back(self);
+  }
+
+  while (true) {
+    uint32_t now = rtos_millis();
+    if (rtos_reached(now, deadline))
+      break;
+
+    pros::c::task_notify_take(true, deadline - now);
+
+    std::lock_guard<rmutex> lock(mutex);
+    if (flag) {
+      remove_waiter(self);
+      return true;
+    }
+  }
+
+  std::lock_guard<rmutex> lock(mutex);
+  remove_waiter(self);
+  return flag;
+}
+
+void Event::remove_waiter(pros::task_t task) {
+  waiters.erase(std::remove(waiters.begin(), waiters.end(), task),
+                waiters.end());
+}
+
+#else
+
+void Event::set() {
+  {
+    std::lock_guard<rmutex> lock(mutex);
+    flag = true;
+  }
+  condition.notify_all();
+}
+
+void Event::wait() {
+  std::unique_lock<rmutex> lock(mutex);
+  condition.wait(lock, [this] { return flag; });
+}
+
+bool Event::wait_for(QTime timeout) {
+  std::unique_lock<rmutex> lock(mutex);
+  return condition.wait_for(
+      lock,
+      std::chrono::microseconds(
+          static_cast<int64_t>(timeout.convert(millisecond) * 1000)),
+      [this] { return flag; });
+}
+
+#endif
+
+void Event::clear() {
+  std::lock_guard<rmutex> lock(mutex);
+  flag = false;
+}
+
+bool Event::is_set() {
+  std::lock_guard<rmutex> lock(mutex);
+  return flag;
+}
+}  // namespace rev
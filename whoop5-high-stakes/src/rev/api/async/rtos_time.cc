@@ -0,0 +1,55 @@
+#include "rev/api/async/rtos_time.hh"
+
+#ifndef OFF_ROBOT_TESTS
+#include "pros/rtos.hpp"
+#else
+#include <chrono>
+#include <thread>
+#endif
+
+namespace rev {
+
+#ifdef OFF_ROBOT_TESTS
+namespace {
+const auto epoch = std::chrono::steady_clock::now();
+}
+#endif
+
+uint32_t rtos_millis() {
+#ifndef OFF_ROBOT_TESTS
+  return pros::millis();
+#else
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - epoch)
+      .count();
+#endif
+}
+
+uint64_t rtos_micros() {
+#ifndef OFF_ROBOT_TESTS
+  return pros::micros();
+#else
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - epoch)
+      .count();
+#endif
+}
+
+void rtos_delay(uint32_t duration) {
+#ifndef OFF_ROBOT_TESTS
+  pros::delay(duration);
+#else
+  std::this_thread::sleep_for(std::chrono::milliseconds(duration));
+#endif
+}
+
+const void* rtos_current_thread() {
+#ifndef OFF_ROBOT_TESTS
+  return pros::c::task_get_current();
+#else
+  // Every thread has its own copy, so its address tells the threads apart
+  static thread_local char marker;
+  return &marker;
+#endif
+}
+}  // namespace rev
@@ -0,0 +1,46 @@
+#include "rev/api/async/runner_stats.hh"
+
+namespace rev {
+
+void RunnerStatsRecorder::record(uint64_t start,
+                                 uint64_t finish,
+                                 bool missed_deadline,
+                                 bool over_budget) {
+  QTime step_time = (finish - start) * 0.001 * millisecond;
+  if (step_time > stats.step_max)
+    stats.step_max = step_time;
+
+  // The first step has nothing to measure a period against
+  if (stats.steps > 0) {
+    uint64_t period_us = start - last_start;
+    QTime period = period_us * 0.001 * millisecond;
+
+    if (periods == 0 || period < stats.period_min)
+      stats.period_min = period;
+    if (period > stats.period_max)
+      stats.period_max = period;
+
+    period_total += period_us;
+    periods++;
+    stats.period_mean = (period_total / (double)periods) * 0.001 * millisecond;
+  }
+
+  if (missed_deadline)
+    stats.missed_deadlines++;
+  if (over_budget)
+    stats.budget_overruns++;
+
+  stats.steps++;
+  last_start = start;
+}
+
+RunnerStats RunnerStatsRecorder::get_stats() const {
+  return stats;
+}
+
+void RunnerStatsRecorder::reset() {
+  stats = RunnerStats();
+  period_total = 0;
+  periods = 0;
+}
+}  // namespace rev
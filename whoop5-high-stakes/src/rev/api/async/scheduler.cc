@@ -0,0 +1,211 @@
+#include "rev/api/async/scheduler.hh"
+
+#include <algorithm>
+#include <mutex>
+
+#include "rev/api/async/rtos_time.hh"
+
+namespace rev {
+
+namespace {
+// Longest the scheduler will sleep, so that newly added runnables get picked
+// up promptly even if nothing else is due
+constexpr uint32_t MAX_IDLE = 10;
+}  // namespace
+
+Scheduler::Scheduler() : Scheduler(RunnerConfig()) {}
+
+Scheduler::Scheduler(RunnerConfig iconfig) : config(iconfig) {
+  start();
+}
+
+Scheduler::~Scheduler() {
+  stop_and_join();
+}
+
+void Scheduler::start() {
+  std::lock_guard<rmutex> lock(lifecycle_mutex);
+  if (thread)
+    return;
+
+  active = true;
+#ifndef OFF_ROBOT_TESTS
+  thread = new rthread(run, this, config.priority, config.stack_depth,
+                       "ReveilLib Scheduler");
+#else
+  thread = new rthread(run, this);
+#endif
+}
+
+void Scheduler::stop_and_join() {
+  std::lock_guard<rmutex> lock(lifecycle_mutex);
+  if (!thread)
+    return;
+
+  active = false;
+  thread->join();
+  delete thread;
+  thread = nullptr;
+
+  // Don't count the time spent stopped as missed deadlines
+  std::lock_guard<rmutex> entries_lock(entries_mutex);
+  for (auto& entry : entries)
+    entry.started = false;
+}
+
+void Scheduler::pause() {
+  paused = true;
+
+  // From inside step() the lock is already held by this thread, and the tick
+  // in progress is the caller's, so there is nothing to wait for
+  if (rtos_current_thread() == loop_thread)
+    return;
+
+  // Wait out a tick which may have started before the flag was set
+  std::lock_guard<rmutex> lock(entries_mutex);
+}
+
+void Scheduler::resume() {
+  std::lock_guard<rmutex> lock(entries_mutex);
+  if (!paused)
+    return;
+
+  for (auto& entry : entries)
+    entry.started = false;
+  paused = false;
+}
+
+void Scheduler::pause(std::shared_ptr<AsyncRunnable> runnable) {
+  std::lock_guard<rmutex> lock(entries_mutex);
+
+  for (auto& entry : entries) {
+    if (entry.runnable == runnable)
+      entry.paused = true;
+  }
+}
+
+void Scheduler::resume(std::shared_ptr<AsyncRunnable> runnable) {
+  std::lock_guard<rmutex> lock(entries_mutex);
+
+  for (auto& entry : entries) {
+    if (entry.runnable == runnable && entry.paused) {
+      entry.paused = false;
+      entry.started = false;
+    }
+  }
+}
+
+bool Scheduler::is_running() {
+  return active;
+}
+
+Scheduler& Scheduler::add(std::shared_ptr<AsyncRunnable> runnable,
+                          int order,
+                          uint32_t period,
+                          QTime budget) {
+  std::lock_guard<rmutex> lock(entries_mutex);
+
+  // Insert after everything with an equal or lower order so that ties are
+  // stepped in the order they were added
+  auto position = std::upper_bound(
+      entries.begin(), entries.end(), order,
+      [](int lhs, const Entry& rhs) { return lhs < rhs.order; });
+  uint64_t budget_us =
+      budget_to_micros(budget > 0_s ? budget : config.budget);
+  entries.insert(position, Entry{runnable, order, std::max<uint32_t>(period, 1),
+                                 0, false, false, budget_us,
+                                 RunnerStatsRecorder()});
+
+  return *this;
+}
+
+void Scheduler::remove(std::shared_ptr<AsyncRunnable> runnable) {
+  std::lock_guard<rmutex> lock(entries_mutex);
+
+  entries.erase(std::remove_if(entries.begin(), entries.end(),
+                               [&](const Entry& entry) {
+                                 return entry.runnable == runnable;
+                               }),
+                entries.end());
+}
+
+RunnerStats Scheduler::get_stats(std::shared_ptr<AsyncRunnable> runnable) {
+  std::lock_guard<rmutex> lock(entries_mutex);
+
+  for (auto& entry : entries) {
+    if (entry.runnable == runnable)
+      return entry.stats.get_stats();
+  }
+  return RunnerStats();
+}
+
+void Scheduler::reset_stats() {
+  std::lock_guard<rmutex> lock(entries_mutex);
+
+  for (auto& entry : entries)
+    entry.stats.reset();
+}
+
+void Scheduler::run(void* context) {
+  if (context)
+    static_cast<Scheduler*>(context)->loop();
+}
+
+void Scheduler::loop() {
+  loop_thread = rtos_current_thread();
+  while (active) {
+    uint32_t next_due = tick(rtos_millis());
+
+    uint32_t now = rtos_millis();
+    if (!rtos_reached(now, next_due))
+      rtos_delay(next_due - now);
+  }
+}
+
+uint32_t Scheduler::tick(uint32_t now) {
+  std::lock_guard<rmutex> lock(entries_mutex);
+
+  uint32_t next_due = now + MAX_IDLE;
+
+  // Checked under the lock so that pause() can wait out a tick in progress
+  if (paused)
+    return next_due;
+
+  for (auto& entry : entries) {
+    if (entry.paused)
+      continue;
+
+    if (!entry.started) {
+      entry.next_due = now;
+      entry.started = true;
+    }
+
+    if (rtos_reached(now, entry.next_due)) {
+      uint64_t start = rtos_micros();
+      entry.runnable->step();
+      uint64_t finish = rtos_micros();
+
+      // Keep the period anchored to the original schedule, but if the next
+      // step is already overdue, skip the missed steps instead of running
+      // them back to back
+      entry.next_due += entry.period;
+      uint32_t after = rtos_millis();
+      bool missed = !rtos_reached(entry.next_due, after);
+      if (missed)
+        entry.next_due = after;
+
+      bool over_budget = entry.budget_us && finish - start > entry.budget_us;
+      entry.stats.record(start, finish, missed, over_budget);
+
+      if (over_budget && config.on_budget_exceeded)
+        config.on_budget_exceeded(*entry.runnable,
+                                  (finish - start) * 0.001 * millisecond);
+    }
+
+    if (rtos_reached(next_due, entry.next_due))
+      next_due = entry.next_due;
+  }
+
+  return next_due;
+}
+}  // namespace rev
@@ -0,0 +1,112 @@
+#include "rev/api/hardware/chassis_sim/driftless_sim.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "rev/api/async/clock.hh"
+
+namespace rev {
+
+DriftlessSim::DriftlessSim(QSpeed iv_max,
+                           QAngularSpeed iw_max,
+                           QFrequency ilinear_decay_rate,
+                           QFrequency iangular_decay_rate,
+                           QFrequency ilinear_brake_decay_rate,
+                           QFrequency iangular_brake_decay_rate)
+    : v_max(iv_max),
+      w_max(iw_max),
+      linear_decay_rate(ilinear_decay_rate),
+      angular_decay_rate(iangular_decay_rate),
+      linear_brake_decay_rate(ilinear_brake_decay_rate),
+      angular_brake_decay_rate(iangular_brake_decay_rate),
+      state{{0_m, 0_m, 0_rad}, {0_mps, 0_mps, 0_rad / second}} {}
+
+void DriftlessSim::drive_tank(double left, double right) {
+  // Scale both sides down together so the ratio between them is kept
+  double max_power = std::max(std::abs(left), std::abs(right));
+  if (max_power > 1.0) {
+    left /= max_power;
+    right /= max_power;
+  }
+
+  linear_power = (left + right) * 0.5;
+  angular_power = (left - right) * 0.5;
+}
+
+void DriftlessSim::drive_arcade(double forward, double yaw) {
+  double total_power = std::abs(forward) + std::abs(yaw);
+  if (total_power > 1.0) {
+    forward /= total_power;
+    yaw /= total_power;
+  }
+
+  linear_power = forward;
+  angular_power = yaw;
+}
+
+void DriftlessSim::set_brake_harsh() {
+  use_harsh_brake_mode = true;
+}
+
+void DriftlessSim::set_brake_coast() {
+  use_harsh_brake_mode = false;
+}
+
+void DriftlessSim::stop() {
+  drive_arcade(0, 0);
+}
+
+OdometryState DriftlessSim::get_state() {
+  return state;
+}
+
+void DriftlessSim::set_position(Position pos) {
+  state.pos = pos;
+}
+
+void DriftlessSim::reset_position() {
+  set_position({0_m, 0_m, 0_rad});
+}
+
+void DriftlessSim::step() {
+  QSpeed v_target = v_max * linear_power;
+  QAngularSpeed w_target = w_max * angular_power;
+
+  int32_t time = get_clock().millis();
+  QTime dt = (time - time_h) * millisecond;
+  time_h = time;
+
+  // Velocities approach their targets exponentially. With no power applied
+  // and harsh braking on, they decay toward zero at the brake rates instead.
+  QSpeed v_next;
+  QAngularSpeed w_next;
+  if (std::abs(linear_power) < 0.005 && std::abs(angular_power) < 0.005 &&
+      use_harsh_brake_mode) {
+    v_next = v_current - dt * v_current * linear_brake_decay_rate;
+    w_next = w_current - dt * w_current * angular_brake_decay_rate;
+  } else {
+    v_next = v_current + (v_target - v_current) * dt * linear_decay_rate;
+    w_next = w_current + (w_target - w_current) * dt * angular_decay_rate;
+  }
+
+  // Integrate along an arc using the average velocities over the step
+  QAngle dtheta = (w_next + w_current) * 0.5 * dt;
+  QLength distance = (v_next + v_current) * 0.5 * dt;
+  if (dtheta != 0_rad)
+    distance = 2 * distance / dtheta.convert(radian) * sin(dtheta * 0.5);
+
+  QAngle heading = state.pos.theta + dtheta * 0.5;
+  double c = cos(heading).convert(number);
+  double s = sin(heading).convert(number);
+
+  state.pos.theta += dtheta;
+  v_current = v_next;
+  w_current = w_next;
+
+  state.vel.angular = w_next;
+  state.vel.xv = v_next * c;
+  state.pos.x += distance * c;
+  state.pos.y += distance * s;
+  state.vel.yv = v_next * s;
+}
+}  // namespace rev
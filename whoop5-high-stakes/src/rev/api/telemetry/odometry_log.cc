@@ -0,0 +1,194 @@
+#include "rev/api/telemetry/odometry_log.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#include "pros/error.h"
+
+namespace rev {
+
+namespace {
+constexpr char LOG_MAGIC[4] = {'R', 'V', 'O', 'L'};
+// Version 1 logs had one inertial and no count in the header, and version 2
+// logs had no drive encoders
+constexpr uint8_t LOG_VERSION = 3;
+constexpr size_t HEADER_SIZE = 8;
+constexpr size_t MAX_RECORD_SIZE = 12 + 4 * MAX_INERTIALS + 8;
+
+size_t record_size(uint8_t version, size_t inertials) {
+  return 12 + 4 * inertials + (version >= 3 ? 8 : 0);
+}
+
+// Both the V5 brain and the hosts we replay on are little-endian, so fields
+// are copied as they sit in memory
+void encode(const OdometrySample& sample, size_t inertials, uint8_t* record) {
+  uint32_t time = static_cast<uint32_t>(sample.time);
+  std::memcpy(record, &time, 4);
+  std::memcpy(record + 4, &sample.longitudinal, 4);
+  std::memcpy(record + 8, &sample.lateral, 4);
+  for (size_t i = 0; i < inertials; i++) {
+    float heading = i < sample.inertial_count()
+                        ? static_cast<float>(sample.inertial_heading(i))
+                        : PROS_ERR_F;
+    std::memcpy(record + 12 + 4 * i, &heading, 4);
+  }
+
+  float left = static_cast<float>(sample.left_drive);
+  float right = static_cast<float>(sample.right_drive);
+  std::memcpy(record + 12 + 4 * inertials, &left, 4);
+  std::memcpy(record + 16 + 4 * inertials, &right, 4);
+}
+
+void decode(const uint8_t* record,
+            uint8_t version,
+            size_t inertials,
+            uint32_t& time,
+            OdometrySample& sample) {
+  std::memcpy(&time, record, 4);
+  std::memcpy(&sample.longitudinal, record + 4, 4);
+  std::memcpy(&sample.lateral, record + 8, 4);
+  sample.extra_inertials = inertials - 1;
+  for (size_t i = 0; i < inertials; i++) {
+    float heading;
+    std::memcpy(&heading, record + 12 + 4 * i, 4);
+    if (i == 0)
+      sample.heading = heading;
+    else
+      sample.extra_headings[i - 1] = heading;
+  }
+
+  sample.left_drive = PROS_ERR_F;
+  sample.right_drive = PROS_ERR_F;
+  if (version >= 3) {
+    float left, right;
+    std::memcpy(&left, record + 12 + 4 * inertials, 4);
+    std::memcpy(&right, record + 16 + 4 * inertials, 4);
+    sample.left_drive = left;
+    sample.right_drive = right;
+  }
+}
+}  // namespace
+
+OdometryLogWriter::OdometryLogWriter(std::shared_ptr<OdometryLogRing> iring,
+                                     const char* path,
+                                     size_t iinertials)
+    : ring(iring),
+      file(std::fopen(path, "wb")),
+      inertials(std::min(std::max<size_t>(iinertials, 1), MAX_INERTIALS)) {
+  if (!file)
+    return;
+
+  uint8_t header[HEADER_SIZE] = {0};
+  std::memcpy(header, LOG_MAGIC, 4);
+  header[4] = LOG_VERSION;
+  header[5] = record_size(LOG_VERSION, inertials);
+  header[6] = inertials;
+  std::fwrite(header, 1, HEADER_SIZE, file);
+}
+
+OdometryLogWriter::~OdometryLogWriter() {
+  if (file)
+    std::fclose(file);
+}
+
+bool OdometryLogWriter::is_open() {
+  return file != nullptr;
+}
+
+void OdometryLogWriter::step() {
+  // Records are batched so each step makes one write to the card
+  uint8_t buffer[MAX_RECORD_SIZE * 32];
+  size_t size = record_size(LOG_VERSION, inertials);
+  size_t used = 0;
+  OdometrySample sample;
+  bool wrote = false;
+
+  while (ring->pop(sample)) {
+    if (!file)
+      continue;
+
+    encode(sample, inertials, buffer + used);
+    used += size;
+    if (used + size > sizeof(buffer)) {
+      std::fwrite(buffer, 1, used, file);
+      used = 0;
+      wrote = true;
+    }
+  }
+
+  if (used > 0) {
+    std::fwrite(buffer, 1, used, file);
+    wrote = true;
+  }
+
+  // Flush so that a log is still usable if the program is stopped
+  if (wrote)
+    std::fflush(file);
+}
+
+OdometryLogReader::OdometryLogReader(const char* path)
+    : file(std::fopen(path, "rb")) {
+  if (!file)
+    return;
+
+  uint8_t header[HEADER_SIZE];
+  bool valid = std::fread(header, 1, HEADER_SIZE, file) == HEADER_SIZE &&
+               std::memcmp(header, LOG_MAGIC, 4) == 0;
+  version = header[4];
+  if (valid && version == 1) {
+    inertials = 1;
+  } else if (valid && version <= LOG_VERSION) {
+    inertials = header[6];
+  } else {
+    valid = false;
+  }
+
+  if (!valid || inertials < 1 || inertials > MAX_INERTIALS ||
+      header[5] != record_size(version, inertials)) {
+    std::fclose(file);
+    file = nullptr;
+  }
+}
+
+OdometryLogReader::~OdometryLogReader() {
+  if (file)
+    std::fclose(file);
+}
+
+bool OdometryLogReader::is_open() {
+  return file != nullptr;
+}
+
+bool OdometryLogReader::next(OdometrySample& sample) {
+  uint8_t record[MAX_RECORD_SIZE];
+  size_t size = record_size(version, inertials);
+  if (!file || std::fread(record, 1, size, file) != size)
+    return false;
+
+  uint32_t wrapped;
+  decode(record, version, inertials, wrapped, sample);
+  if (started)
+    time += static_cast<uint32_t>(wrapped - time_last);
+  else
+    time = wrapped;
+  time_last = wrapped;
+  started = true;
+
+  sample.time = time;
+  return true;
+}
+
+size_t replay_odometry_log(OdometryLogReader& log,
+                           SampledOdometry& odometry,
+                           ReplaySink sink) {
+  size_t count = 0;
+  OdometrySample sample;
+  while (log.next(sample)) {
+    odometry.add_sample(sample);
+    if (sink)
+      sink(sample, odometry.get_state());
+    count++;
+  }
+  return count;
+}
+}  // namespace rev
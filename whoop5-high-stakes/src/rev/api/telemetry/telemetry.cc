@@ -0,0 +1,28 @@
+#include "rev/api/telemetry/telemetry.hh"
+
+#include <cstdio>
+
+namespace rev {
+
+void print_telemetry(const TelemetryRecord& record) {
+  std::printf("%lu,%.3f,%.3f,%.2f,%.3f,%.3f,%.2f,%.3f,%.3f,%d,%lu\n",
+              static_cast<unsigned long>(record.time),
+              record.pos.x.convert(inch), record.pos.y.convert(inch),
+              record.pos.theta.convert(degree),
+              record.vel.xv.convert(inch / second),
+              record.vel.yv.convert(inch / second),
+              record.vel.angular.convert(degree / second), record.left_power,
+              record.right_power, static_cast<int>(record.stop),
+              static_cast<unsigned long>(record.segment));
+}
+
+TelemetryDrain::TelemetryDrain(std::shared_ptr<TelemetryRing> iring,
+                               TelemetrySink isink)
+    : ring(iring), sink(isink) {}
+
+void TelemetryDrain::step() {
+  TelemetryRecord record;
+  while (ring->pop(record))
+    sink(record);
+}
+}  // namespace rev
@@ -0,0 +1,57 @@
+#include "rev/util/math/pose.hh"
+
+#include <cmath>
+
+namespace rev {
+
+Pose Pose::to_relative(const Pose reference) const {
+  QLength dx = x - reference.x;
+  QLength dy = y - reference.y;
+  Number c = cos(reference.theta);
+  Number s = sin(reference.theta);
+
+  return Pose{{c * dx + s * dy, c * dy - s * dx}, theta - reference.theta};
+}
+
+Pose Pose::to_absolute(const Pose reference) const {
+  Number c = cos(reference.theta);
+  Number s = sin(reference.theta);
+
+  return Pose{{c * x - s * y + reference.x, s * x + c * y + reference.y},
+              theta + reference.theta};
+}
+
+Pose interpolate(const Pose& from, const Pose& to, double fraction) {
+  Pose delta = to.to_relative(from);
+  double dx = delta.x.convert(meter);
+  double dy = delta.y.convert(meter);
+  double dtheta = std::remainder(delta.theta.convert(radian), 2 * M_PI);
+
+  // The travel is V * u for the twist u which is constant along the arc, with
+  // V = [a -b; b a]. Scaling the twist by the fraction and mapping it back
+  // gives the point that far along the arc.
+  auto coefficients = [](double theta, double& a, double& b) {
+    if (std::abs(theta) < 1e-9) {
+      a = 1.0;
+      b = theta * 0.5;
+    } else {
+      a = std::sin(theta) / theta;
+      b = (1.0 - std::cos(theta)) / theta;
+    }
+  };
+
+  double a, b;
+  coefficients(dtheta, a, b);
+  double det = a * a + b * b;
+  double ux = (a * dx + b * dy) / det;
+  double uy = (a * dy - b * dx) / det;
+
+  double partial_theta = dtheta * fraction;
+  coefficients(partial_theta, a, b);
+  double px = fraction * (a * ux - b * uy);
+  double py = fraction * (b * ux + a * uy);
+
+  return Pose{{px * meter, py * meter}, partial_theta * radian}.to_absolute(
+      from);
+}
+}  // namespace rev
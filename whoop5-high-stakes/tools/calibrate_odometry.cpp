@@ -0,0 +1,120 @@
+// Fits the tracking wheel diameters and offsets to a logged calibration run.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "rev/api/alg/odometry/tracking_wheel_calibration.hh"
+#include "rev/api/telemetry/odometry_log.hh"
+
+using namespace rev;
+
+namespace {
+struct Segment {
+  CalibrationMotion motion;
+  uint64_t start;  // micros
+  uint64_t end;
+  QLength distance;
+};
+
+bool parse_segment(const std::string& spec, Segment& segment) {
+  std::vector<std::string> fields;
+  size_t begin = 0;
+  while (true) {
+    size_t colon = spec.find(':', begin);
+    fields.push_back(spec.substr(begin, colon - begin));
+    if (colon == std::string::npos)
+      break;
+    begin = colon + 1;
+  }
+
+  if (fields[0] == "spin" && fields.size() == 3)
+    segment.motion = CalibrationMotion::SPIN;
+  else if (fields[0] == "forward" && fields.size() == 4)
+    segment.motion = CalibrationMotion::FORWARD;
+  else if (fields[0] == "sideways" && fields.size() == 4)
+    segment.motion = CalibrationMotion::SIDEWAYS;
+  else
+    return false;
+
+  segment.start = static_cast<uint64_t>(std::atof(fields[1].c_str()) * 1e6);
+  segment.end = static_cast<uint64_t>(std::atof(fields[2].c_str()) * 1e6);
+  segment.distance =
+      fields.size() == 4 ? std::atof(fields[3].c_str()) * inch : 0_in;
+  return segment.end > segment.start;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::fprintf(stderr,
+                 "usage: calibrate_odometry LOG SEGMENT...\n"
+                 "  SEGMENT is spin:START:END, forward:START:END:INCHES or\n"
+                 "  sideways:START:END:INCHES, with times in seconds\n");
+    return 1;
+  }
+
+  std::vector<Segment> segments;
+  for (int i = 2; i < argc; i++) {
+    Segment segment;
+    if (!parse_segment(argv[i], segment)) {
+      std::fprintf(stderr, "bad segment %s\n", argv[i]);
+      return 1;
+    }
+    segments.push_back(segment);
+  }
+
+  OdometryLogReader log(argv[1]);
+  if (!log.is_open()) {
+    std::fprintf(stderr, "could not read an odometry log from %s\n", argv[1]);
+    return 1;
+  }
+
+  // Feed the samples inside each segment. Segments may be given in any order
+  // but must not overlap.
+  TrackingWheelCalibrator calibrator;
+  const Segment* current = nullptr;
+  OdometrySample sample;
+  while (log.next(sample)) {
+    if (current && sample.time > current->end) {
+      calibrator.end_segment();
+      current = nullptr;
+    }
+    if (!current) {
+      for (const Segment& segment : segments) {
+        if (sample.time >= segment.start && sample.time <= segment.end) {
+          current = &segment;
+          calibrator.begin_segment(segment.motion, segment.distance);
+          break;
+        }
+      }
+    }
+    calibrator.add_sample(sample);
+  }
+  calibrator.end_segment();
+
+  WheelCalibration result;
+  if (!calibrator.solve(result)) {
+    std::fprintf(stderr,
+                 "not enough data: record at least one spin and one forward "
+                 "line\n");
+    return 1;
+  }
+
+  std::printf("#define FORWARD_WHEEL_DIAMETER %.2f_mm\n",
+              result.longitudinal_wheel_diameter.convert(millimeter));
+  std::printf("#define LATERAL_WHEEL_DIAMETER %.2f_mm%s\n",
+              result.lateral_wheel_diameter.convert(millimeter),
+              result.lateral_diameter_fitted
+                  ? ""
+                  : " // not fitted, assumed the same as the forward wheel");
+  std::printf("#define FORWARD_WHEEL_OFFSET %.3f_in\n",
+              result.longitudinal_wheel_offset.convert(inch));
+  std::printf("#define LATERAL_WHEEL_OFFSET %.3f_in\n",
+              result.lateral_wheel_offset.convert(inch));
+  std::printf("// residuals: longitudinal %.3f in, lateral %.3f in\n",
+              result.longitudinal_residual.convert(inch),
+              result.lateral_residual.convert(inch));
+  return 0;
+}
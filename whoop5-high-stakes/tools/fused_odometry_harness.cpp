@@ -0,0 +1,259 @@
+// Measures how closely FixCorrectedOdometry with a GPS tracks a skills run.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+
+#include "rev/api/alg/drive/correction/pilons_correction.hh"
+#include "rev/api/alg/drive/motion/cascading_motion.hh"
+#include "rev/api/alg/drive/stop/simple_stop.hh"
+#include "rev/api/alg/odometry/fix_corrected_odometry.hh"
+#include "rev/api/alg/reckless/reckless.hh"
+#include "rev/api/async/clock.hh"
+#include "rev/api/hardware/chassis_sim/driftless_sim.hh"
+
+using namespace rev;
+
+namespace {
+const QTime TIMESTEP = 10_ms;
+const QTime RUN_TIME = 60_s;
+const QTime WINDOW = 10_s;
+
+// A new GPS fix every this many steps
+const int GPS_STEPS = 5;
+const QLength GPS_NOISE = 1.5_cm;
+const QAngle GPS_HEADING_NOISE = 1_deg;
+// Share of fixes which are reflections, reported with the usual error
+const double GPS_OUTLIER_RATE = 0.03;
+// The GPS can't see the field strips while facing a wall for this stretch
+const QTime DARK_START = 20_s;
+const QTime DARK_END = 26_s;
+
+// When the robot is shoved sideways by another robot, and by how much
+const QTime SHOVE_TIME = 40_s;
+const QLength SHOVE = 10_in;
+
+/**
+ * @brief Follows the sim like tracking wheels would, with the wheels reading
+ * slightly long, the inertial slightly over-reading turns, and some noise
+ *
+ */
+class DriftingOdometry : public Odometry {
+ public:
+  DriftingOdometry(std::shared_ptr<DriftlessSim> isim, std::mt19937& irandom)
+      : sim(isim), random(irandom) {}
+
+  OdometryState get_state() override { return state; }
+  void set_position(Position pos) override { state.pos = pos; }
+  void reset_position() override { set_position({0_in, 0_in, 0_deg}); }
+
+  void step() {
+    OdometryState truth = sim->get_state();
+    Pose motion = truth.pos.to_relative(truth_last);
+    truth_last = truth.pos;
+
+    std::normal_distribution<double> noise(0.0, 1.0);
+    motion.x *= 1.015;
+    motion.y *= 1.015;
+    motion.theta = motion.theta * 1.005 + noise(random) * 0.01_deg;
+    state.pos = motion.to_absolute(state.pos);
+
+    // The velocity is the sim's, rotated into this odometry's heading
+    double rotation = (state.pos.theta - truth.pos.theta).convert(radian);
+    double c = std::cos(rotation), s = std::sin(rotation);
+    state.vel = {c * truth.vel.xv - s * truth.vel.yv,
+                 s * truth.vel.xv + c * truth.vel.yv, truth.vel.angular};
+  }
+
+  /**
+   * @brief Misses whatever the sim did since the last step, as when the robot
+   * is pushed and the tracking wheels skid
+   *
+   */
+  void miss_motion() { truth_last = sim->get_state().pos; }
+
+ private:
+  std::shared_ptr<DriftlessSim> sim;
+  std::mt19937& random;
+  Pose truth_last{{0_in, 0_in}, 0_deg};
+  OdometryState state{{{0_in, 0_in}, 0_deg}, {0_mps, 0_mps, 0_deg / second}};
+};
+
+QLength position_error(const Pose& estimate, const Pose& truth) {
+  return abs(estimate - truth);
+}
+
+double heading_error(const Pose& estimate, const Pose& truth) {
+  return std::abs(
+      std::remainder((estimate.theta - truth.theta).convert(degree), 360.0));
+}
+
+RecklessPath make_route() {
+  // Out and back across the field and up and down a column, the same route
+  // reckless_sweep tunes on
+  const Position waypoints[] = {
+      {48_in, 0_in, 0_deg},   {48_in, 24_in, 0_deg},  {0_in, 24_in, 0_deg},
+      {0_in, 48_in, 0_deg},   {48_in, 48_in, 0_deg},  {72_in, 24_in, 0_deg},
+      {24_in, 0_in, 0_deg},   {24_in, 36_in, 0_deg},  {60_in, 36_in, 0_deg},
+      {60_in, 0_in, 0_deg},   {12_in, 12_in, 0_deg},  {0_in, 0_in, 0_deg}};
+
+  RecklessPath path;
+  for (const Position& waypoint : waypoints)
+    path.with_segment(RecklessPathSegment(
+        CascadingMotion(1.0, 0.02, 1.0 / 60, 60 * inch / second, 0.08),
+        PilonsCorrection(4.0, 0.5_in), SimpleStop(0.03_s, 0.2_s, 0.2, 3_s),
+        waypoint));
+  return path;
+}
+
+struct Window {
+  double odometry_position{0}, odometry_heading{0};
+  double fused_position{0}, fused_heading{0};
+};
+}  // namespace
+
+int main() {
+  auto clock = std::make_shared<VirtualClock>();
+  set_clock(clock);
+  std::mt19937 random(1);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+  auto sim = std::make_shared<DriftlessSim>(60 * inch / second,
+                                            10 * radian / second, 6_Hz, 8_Hz,
+                                            20_Hz, 20_Hz);
+  auto odometry = std::make_shared<DriftingOdometry>(sim, random);
+  FixCorrectedOdometry fused(odometry);
+  fused.set_position({0_in, 0_in, 0_deg});
+
+  auto reckless = std::make_shared<Reckless>(sim, sim);
+  RecklessPath route = make_route();
+
+  // Reckless reports each state change, which would bury the results
+  std::stringstream discard;
+  std::streambuf* cout_buffer = std::cout.rdbuf(discard.rdbuf());
+
+  Window windows[6];
+  uint32_t outliers = 0;
+  uint32_t outliers_fused = 0;
+  QTime time = 0_s;
+  QTime recovered_at = 0_s;
+  int routes = 0;
+  const int shove_step = std::lround(SHOVE_TIME.convert(second) /
+                                     TIMESTEP.convert(second));
+  for (int step = 1; time < RUN_TIME; step++) {
+    if (reckless->is_completed()) {
+      reckless->go(route);
+      routes++;
+    }
+    clock->advance(TIMESTEP);
+    time += TIMESTEP;
+    sim->step();
+    reckless->step();
+
+    if (step == shove_step) {
+      Pose pos = sim->get_state().pos;
+      sim->set_position(
+          {pos.x - SHOVE * std::sin(pos.theta.convert(radian)),
+           pos.y + SHOVE * std::cos(pos.theta.convert(radian)), pos.theta});
+      odometry->miss_motion();
+    }
+    odometry->step();
+
+    Pose truth = sim->get_state().pos;
+    bool dark = time >= DARK_START && time < DARK_END;
+    if (step % GPS_STEPS == 0 && !dark) {
+      Pose fix{{truth.x + noise(random) * GPS_NOISE,
+                truth.y + noise(random) * GPS_NOISE},
+               truth.theta + noise(random) * GPS_HEADING_NOISE};
+      bool outlier = uniform(random) < GPS_OUTLIER_RATE;
+      if (outlier) {
+        double direction = uniform(random) * 2 * M_PI;
+        QLength distance = (30 + 30 * uniform(random)) * centimeter;
+        fix.x += distance * std::cos(direction);
+        fix.y += distance * std::sin(direction);
+        outliers++;
+      }
+      uint32_t rejected = fused.get_rejected_fixes();
+      fused.update(fix, GPS_NOISE);
+      if (outlier && fused.get_rejected_fixes() == rejected)
+        outliers_fused++;
+    } else {
+      fused.update();
+    }
+
+    Pose odometry_pos = odometry->get_state().pos;
+    Pose fused_pos = fused.get_state().pos;
+    Window& window = windows[std::min<size_t>(
+        static_cast<size_t>(time.convert(second) / WINDOW.convert(second)),
+        5)];
+    window.odometry_position =
+        std::max(window.odometry_position,
+                 position_error(odometry_pos, truth).convert(inch));
+    window.odometry_heading =
+        std::max(window.odometry_heading, heading_error(odometry_pos, truth));
+    window.fused_position = std::max(
+        window.fused_position, position_error(fused_pos, truth).convert(inch));
+    window.fused_heading =
+        std::max(window.fused_heading, heading_error(fused_pos, truth));
+
+    if (time > SHOVE_TIME && recovered_at == 0_s &&
+        position_error(fused_pos, truth) < 2_in)
+      recovered_at = time;
+  }
+  std::cout.rdbuf(cout_buffer);
+
+  Pose truth = sim->get_state().pos;
+  Pose fused_end = fused.get_state().pos;
+
+  // get_state() is a seqlock read, the same as the tracking wheel odometry
+  const int reads = 1000000;
+  auto start = std::chrono::steady_clock::now();
+  double sink = 0;
+  for (int i = 0; i < reads; i++)
+    sink += fused.get_state().pos.x.convert(meter);
+  double read_time = std::chrono::duration<double, std::nano>(
+                         std::chrono::steady_clock::now() - start)
+                         .count() /
+                     reads;
+  set_clock(nullptr);
+
+  std::printf("%d laps of the route in %.0f s, fixes every %d ms with %.1f cm "
+              "noise, dark from %.0f to %.0f s, shoved %.0f in at %.0f s\n\n",
+              routes, RUN_TIME.convert(second),
+              GPS_STEPS * (int)TIMESTEP.convert(millisecond),
+              GPS_NOISE.convert(centimeter), DARK_START.convert(second),
+              DARK_END.convert(second), SHOVE.convert(inch),
+              SHOVE_TIME.convert(second));
+  std::printf("%-10s %18s %18s %18s %18s\n", "window", "odometry max (in)",
+              "odometry max (deg)", "fused max (in)", "fused max (deg)");
+  for (size_t i = 0; i < 6; i++)
+    std::printf("%3zu-%-3zu s  %18.2f %18.2f %18.2f %18.2f\n", i * 10,
+                (i + 1) * 10, windows[i].odometry_position,
+                windows[i].odometry_heading, windows[i].fused_position,
+                windows[i].fused_heading);
+
+  QLength final_error = position_error(fused_end, truth);
+  std::printf("\nfused final error %.2f in, %u of %u outliers let through, "
+              "%u fixes rejected in all, %u reseeds\n",
+              final_error.convert(inch), outliers_fused, outliers,
+              fused.get_rejected_fixes(), fused.get_reseeds());
+  std::printf("back within 2 in %.2f s after the shove\n",
+              (recovered_at - SHOVE_TIME).convert(second));
+  std::printf("get_state() %.1f ns (checksum %.0f)\n", read_time, sink);
+
+  // Away from the dark stretch and the shove, the GPS should hold the error
+  // within a few inches
+  bool ok = final_error < 2_in && outliers_fused == 0 &&
+            fused.get_reseeds() >= 1 && recovered_at > 0_s;
+  for (size_t i : {0, 1, 3, 5})
+    ok = ok && windows[i].fused_position < 3;
+  if (!ok)
+    std::printf("fused odometry did not hold its bound\n");
+  return ok ? 0 : 1;
+}
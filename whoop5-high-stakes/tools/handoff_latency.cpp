@@ -0,0 +1,106 @@
+// Measures how long a waiting thread takes to notice a motion finished.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "rev/api/alg/drive/correction/pilons_correction.hh"
+#include "rev/api/alg/drive/motion/cascading_motion.hh"
+#include "rev/api/alg/drive/stop/simple_stop.hh"
+#include "rev/api/alg/reckless/reckless.hh"
+#include "rev/api/async/async_runner.hh"
+#include "rev/api/async/rtos_time.hh"
+#include "rev/api/hardware/chassis_sim/driftless_sim.hh"
+
+using namespace rev;
+
+namespace {
+/**
+ * @brief Steps the sim and Reckless together, and records when Reckless
+ * finishes each segment
+ *
+ */
+class SimulatedRobot : public AsyncRunnable {
+ public:
+  SimulatedRobot()
+      : sim(std::make_shared<DriftlessSim>(60 * inch / second,
+                                           10 * radian / second, 6_Hz, 8_Hz,
+                                           20_Hz, 20_Hz)),
+        reckless(std::make_shared<Reckless>(sim, sim)) {}
+
+  void step() override {
+    sim->step();
+    bool was_active = !reckless->is_completed();
+    reckless->step();
+    if (was_active && reckless->is_completed())
+      done_us = rtos_micros();
+  }
+
+  std::shared_ptr<DriftlessSim> sim;
+  std::shared_ptr<Reckless> reckless;
+  std::atomic<uint64_t> done_us{0};
+};
+
+enum class WaitMethod { AWAIT, AWAIT_FOR, POLL };
+
+void run(SimulatedRobot& robot,
+         WaitMethod method,
+         int segments,
+         const char* name) {
+  std::vector<double> latencies;
+  for (int i = 0; i < segments; i++) {
+    // Back and forth along the same line
+    Position target{i % 2 == 0 ? 6_in : 0_in, 0_in, 0_deg};
+    robot.reckless->go(RecklessPath().with_segment(RecklessPathSegment(
+        CascadingMotion(1.0, 0.02, 1.0 / 60), PilonsCorrection(4, 0.5_in),
+        SimpleStop(0.03_s, 0.15_s, 0.3), target)));
+
+    switch (method) {
+      case WaitMethod::AWAIT:
+        robot.reckless->await();
+        break;
+      case WaitMethod::AWAIT_FOR:
+        while (!robot.reckless->await_for(20_ms)) {
+        }
+        break;
+      case WaitMethod::POLL:
+        while (!robot.reckless->is_completed())
+          rtos_delay(20);
+        break;
+    }
+    latencies.push_back((rtos_micros() - robot.done_us) / 1000.0);
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  double total = 0;
+  for (double latency : latencies)
+    total += latency;
+  std::printf("%-24s %10.3f %10.3f %10.3f\n", name, total / latencies.size(),
+              latencies[latencies.size() / 2], latencies.back());
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  int segments = std::max(argc > 1 ? std::atoi(argv[1]) : 10, 1);
+
+  // Reckless reports each state change, which would bury the results
+  std::stringstream discard;
+  std::streambuf* cout_buffer = std::cout.rdbuf(discard.rdbuf());
+
+  auto robot = std::make_shared<SimulatedRobot>();
+  AsyncRunner runner(robot, 10);
+
+  std::printf("%-24s %10s %10s %10s\n", "wait method", "mean (ms)",
+              "p50 (ms)", "max (ms)");
+  run(*robot, WaitMethod::AWAIT, segments, "await()");
+  run(*robot, WaitMethod::AWAIT_FOR, segments, "await_for(20_ms) loop");
+  run(*robot, WaitMethod::POLL, segments, "poll every 20ms");
+
+  runner.stop_and_join();
+  std::cout.rdbuf(cout_buffer);
+  return 0;
+}
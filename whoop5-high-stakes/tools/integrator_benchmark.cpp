@@ -0,0 +1,204 @@
+// Measures the accuracy and cost of each odometry integrator.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rev/api/alg/odometry/tracking_wheel_odometry.hh"
+#include "rev/api/telemetry/odometry_log.hh"
+
+using namespace rev;
+
+namespace {
+// Matches the robot in globals.hh
+const double WHEEL_DIAMETER = 0.06389;         // meters
+const double LONGITUDINAL_OFFSET = -0.028575;  // meters, to the right
+const double LATERAL_OFFSET = -0.0254;         // meters, backward
+
+const OdometryIntegrator INTEGRATORS[] = {OdometryIntegrator::EULER,
+                                          OdometryIntegrator::MIDPOINT,
+                                          OdometryIntegrator::EXPONENTIAL};
+const char* const INTEGRATOR_NAMES[] = {"euler", "midpoint", "exponential"};
+
+struct TruePose {
+  double x, y, theta;  // Meters and radians, theta clockwise
+  double longitudinal, lateral;  // Distance each wheel has rolled, meters
+};
+
+/**
+ * @brief Integrates the drive below with RK4 in 0.1 ms steps
+ *
+ * Forward speed, sideways slip and turn rate all vary smoothly, and the turn
+ * rate reaches 250 deg/s, which is a fast sweep for a skid steer
+ *
+ * @param duration In seconds
+ * @return std::vector<TruePose> The pose every 0.1 ms
+ */
+std::vector<TruePose> true_path(double duration) {
+  const double dt = 0.0001;
+  auto derivative = [](double t, const TruePose& pose) {
+    double v = 1.0 + 0.5 * std::sin(0.7 * t);                 // m/s forward
+    double u = 0.08 * std::sin(2.1 * t);                       // m/s right
+    double w = 250 * M_PI / 180 * std::sin(1.3 * t + 0.4);    // rad/s
+    double c = std::cos(pose.theta), s = std::sin(pose.theta);
+    return TruePose{v * c - u * s, v * s + u * c, w,
+                    v - LONGITUDINAL_OFFSET * w, u - LATERAL_OFFSET * w};
+  };
+  auto add = [](const TruePose& a, const TruePose& b, double k) {
+    return TruePose{a.x + k * b.x, a.y + k * b.y, a.theta + k * b.theta,
+                    a.longitudinal + k * b.longitudinal,
+                    a.lateral + k * b.lateral};
+  };
+
+  std::vector<TruePose> path{{0, 0, 0, 0, 0}};
+  for (double t = 0; t < duration; t += dt) {
+    const TruePose& p = path.back();
+    TruePose k1 = derivative(t, p);
+    TruePose k2 = derivative(t + dt / 2, add(p, k1, dt / 2));
+    TruePose k3 = derivative(t + dt / 2, add(p, k2, dt / 2));
+    TruePose k4 = derivative(t + dt, add(p, k3, dt));
+    TruePose next = add(p, k1, dt / 6);
+    next = add(next, k2, dt / 3);
+    next = add(next, k3, dt / 3);
+    next = add(next, k4, dt / 6);
+    path.push_back(next);
+  }
+  return path;
+}
+
+/**
+ * @brief Turns the true path into sensor readings, rounded the way the
+ * sensors and the log round them
+ *
+ */
+OdometrySample reading(const TruePose& pose, uint64_t time) {
+  auto centidegrees = [](double distance) {
+    return static_cast<int32_t>(
+        std::lround(distance / (M_PI * WHEEL_DIAMETER) * 36000));
+  };
+  double heading = std::fmod(pose.theta * 180 / M_PI, 360.0);
+  if (heading < 0)
+    heading += 360;
+  return OdometrySample{time, centidegrees(pose.longitudinal),
+                        centidegrees(pose.lateral),
+                        static_cast<float>(heading)};
+}
+
+std::unique_ptr<TrackingWheelOdometry> make_odometry(
+    OdometryIntegrator integrator) {
+  auto odometry = std::make_unique<TrackingWheelOdometry>(
+      WHEEL_DIAMETER * meter, WHEEL_DIAMETER * meter,
+      LONGITUDINAL_OFFSET * meter, LATERAL_OFFSET * meter);
+  odometry->set_integrator(integrator);
+  return odometry;
+}
+
+/**
+ * @brief Times integrate_odometry alone over a stream of steps
+ *
+ * @return double Nanoseconds per step
+ */
+double time_integrator(OdometryIntegrator integrator,
+                       const std::vector<OdometryDelta>& deltas) {
+  const int repeats = 200;
+  double sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < repeats; r++) {
+    for (const OdometryDelta& delta : deltas) {
+      PointVector displacement =
+          integrate_odometry(integrator, delta, LONGITUDINAL_OFFSET * meter,
+                             LATERAL_OFFSET * meter);
+      sink += displacement.x.convert(meter);
+    }
+  }
+  double elapsed = std::chrono::duration<double, std::nano>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  // Keeps the loop from being optimized away
+  if (sink == 1234.5)
+    std::printf(" ");
+  return elapsed / (repeats * deltas.size());
+}
+
+void synthetic() {
+  const double duration = 15;
+  std::vector<TruePose> path = true_path(duration);
+
+  std::printf("%-10s %-12s %12s %12s %12s %14s\n", "period", "integrator",
+              "final (in)", "max (in)", "step (ns)", "add_sample (ns)");
+  for (int period_ms : {2, 5, 10, 20}) {
+    size_t stride = period_ms * 10;
+
+    std::vector<OdometrySample> samples;
+    std::vector<OdometryDelta> deltas;
+    for (size_t i = 0; i < path.size(); i += stride) {
+      samples.push_back(reading(path[i], i * 100));
+      if (i >= stride) {
+        const TruePose& a = path[i - stride];
+        const TruePose& b = path[i];
+        deltas.push_back({(b.longitudinal - a.longitudinal) * meter,
+                          (b.lateral - a.lateral) * meter,
+                          (b.theta - a.theta) * radian, b.theta * radian});
+      }
+    }
+
+    for (size_t k = 0; k < 3; k++) {
+      auto odometry = make_odometry(INTEGRATORS[k]);
+      double max_error = 0, error = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < samples.size(); i++) {
+        odometry->add_sample(samples[i]);
+        OdometryState state = odometry->get_state();
+        const TruePose& truth = path[i * stride];
+        error = std::hypot(state.pos.x.convert(meter) - truth.x,
+                           state.pos.y.convert(meter) - truth.y) /
+                0.0254;
+        max_error = std::max(max_error, error);
+      }
+      double add_sample = std::chrono::duration<double, std::nano>(
+                              std::chrono::steady_clock::now() - start)
+                              .count() /
+                          samples.size();
+
+      std::printf("%-10s %-12s %12.3f %12.3f %12.1f %14.1f\n",
+                  (std::to_string(period_ms) + " ms").c_str(),
+                  INTEGRATOR_NAMES[k], error, max_error,
+                  time_integrator(INTEGRATORS[k], deltas), add_sample);
+    }
+  }
+}
+
+int replay(const char* path) {
+  Position ends[3];
+  size_t count = 0;
+  for (size_t k = 0; k < 3; k++) {
+    OdometryLogReader log(path);
+    if (!log.is_open()) {
+      std::fprintf(stderr, "could not read an odometry log from %s\n", path);
+      return 1;
+    }
+    auto odometry = make_odometry(INTEGRATORS[k]);
+    count = replay_odometry_log(
+        log, *odometry, [](const OdometrySample&, const OdometryState&) {});
+    ends[k] = odometry->get_state().pos;
+  }
+
+  std::printf("\n%s, %zu samples, distance from the exponential end point\n",
+              path, count);
+  for (size_t k = 0; k < 3; k++)
+    std::printf("%-12s %8.3f in\n", INTEGRATOR_NAMES[k],
+                abs(ends[k] - ends[2]).convert(inch));
+  return 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  synthetic();
+  if (argc > 1)
+    return replay(argv[1]);
+  return 0;
+}
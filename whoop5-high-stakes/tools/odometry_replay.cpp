@@ -0,0 +1,361 @@
+// Replays an odometry log, printing the poses, faults and velocity noise.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rev/api/alg/odometry/tracking_wheel_odometry.hh"
+#include "rev/api/telemetry/odometry_log.hh"
+
+using namespace rev;
+
+namespace {
+void usage() {
+  std::fprintf(stderr,
+               "usage: odometry_replay LOG [--trace] [--compare-estimators]\n"
+               "  [--integrator euler|midpoint|exponential]\n"
+               "  [--longitudinal-diameter MM] [--lateral-diameter MM]\n"
+               "  [--longitudinal-offset IN] [--lateral-offset IN]\n"
+               "  [--estimator raw|ema:ALPHA|ls:WINDOW|kalman:Q,R]...\n"
+               "  [--inertial-scales S1,S2,...] [--no-bias]\n"
+               "  [--drive WHEEL_IN,GEAR_RATIO,TRACK_IN]\n");
+}
+
+std::unique_ptr<VelocityEstimator> parse_estimator(const std::string& spec) {
+  size_t colon = spec.find(':');
+  std::string name = spec.substr(0, colon);
+  const char* args = colon == std::string::npos ? "" : spec.c_str() + colon + 1;
+
+  if (name == "raw")
+    return std::make_unique<RawVelocity>();
+  if (name == "ema")
+    return std::make_unique<EmaVelocity>(std::atof(args));
+  if (name == "ls")
+    return std::make_unique<LeastSquaresVelocity>(std::atoi(args));
+  if (name == "kalman") {
+    const char* comma = std::strchr(args, ',');
+    if (comma)
+      return std::make_unique<KalmanVelocity>(std::atof(args),
+                                              std::atof(comma + 1));
+  }
+  return nullptr;
+}
+
+const char* fault_name(SensorFault fault) {
+  switch (fault) {
+    case SensorFault::NONE:
+      return "ok";
+    case SensorFault::ERROR_CODE:
+      return "error code";
+    case SensorFault::STALE:
+      return "stale";
+    case SensorFault::JUMP:
+      return "jump";
+  }
+  return "?";
+}
+
+typedef std::function<std::unique_ptr<TrackingWheelOdometry>(
+    const VelocityEstimator&)>
+    OdometryFactory;
+
+// One velocity component from a replay, in the units it is printed in
+typedef std::vector<double> Trace;
+
+/**
+ * @brief Least squares slope of a trace over the samples centered on i
+ *
+ * Centering the window means it has no lag, and fitting spreads the weight
+ * over the window so the noise it shares with any one estimate stays small
+ */
+double centered_slope(const std::vector<double>& times,
+                      const Trace& values,
+                      size_t i,
+                      size_t half) {
+  double mean_time = 0, mean_value = 0;
+  for (size_t j = i - half; j <= i + half; j++) {
+    mean_time += times[j];
+    mean_value += values[j];
+  }
+  mean_time /= 2 * half + 1;
+  mean_value /= 2 * half + 1;
+
+  double covariance = 0, variance = 0;
+  for (size_t j = i - half; j <= i + half; j++) {
+    covariance += (times[j] - mean_time) * (values[j] - mean_value);
+    variance += (times[j] - mean_time) * (times[j] - mean_time);
+  }
+  return covariance / variance;
+}
+
+/**
+ * @brief Finds the shift of an estimate behind the reference that fits best
+ *
+ * Several components, such as x and y, are shifted together and their errors
+ * pooled
+ *
+ * @param estimates
+ * @param references Zero where the reference window runs off the log
+ * @param valid Number of samples at each end the references do not cover
+ * @param max_shift Largest shift to try, in samples
+ * @param[out] noise RMS difference per component at the best shift
+ * @return size_t The best shift, in samples
+ */
+size_t best_shift(const std::vector<const Trace*>& estimates,
+                  const std::vector<const Trace*>& references,
+                  size_t valid,
+                  size_t max_shift,
+                  double& noise) {
+  size_t best = 0;
+  noise = INFINITY;
+  size_t size = references.front()->size();
+  for (size_t shift = 0; shift <= max_shift; shift++) {
+    double sum = 0;
+    size_t count = 0;
+    for (size_t i = valid + shift; i + valid < size; i++) {
+      for (size_t k = 0; k < estimates.size(); k++) {
+        double error = (*estimates[k])[i] - (*references[k])[i - shift];
+        sum += error * error;
+        count++;
+      }
+    }
+    if (count > 0 && std::sqrt(sum / count) < noise) {
+      noise = std::sqrt(sum / count);
+      best = shift;
+    }
+  }
+  return best;
+}
+
+int compare_estimators(const char* path,
+                       const std::vector<std::string>& specs,
+                       const OdometryFactory& make_odometry) {
+  const double reference_window = 0.025;  // Seconds either side
+  const double max_lag = 0.2;             // Seconds
+
+  std::printf("%-16s %14s %10s %16s %10s\n", "estimator",
+              "noise (in/s)", "lag (ms)", "noise (deg/s)", "lag (ms)");
+
+  std::vector<double> times;
+  Trace x, y, theta, xv_reference, yv_reference, angular_reference;
+  size_t half = 1;
+  double period = 0;
+  for (const std::string& spec : specs) {
+    std::unique_ptr<VelocityEstimator> estimator = parse_estimator(spec);
+    OdometryLogReader log(path);
+    if (!log.is_open()) {
+      std::fprintf(stderr, "could not read an odometry log from %s\n", path);
+      return 1;
+    }
+
+    auto odometry = make_odometry(*estimator);
+    Trace xv, yv, angular;
+    bool first = times.empty();
+    replay_odometry_log(
+        log, *odometry,
+        [&](const OdometrySample& sample, const OdometryState& state) {
+          if (first) {
+            times.push_back(sample.time * 1e-6);
+            x.push_back(state.pos.x.convert(inch));
+            y.push_back(state.pos.y.convert(inch));
+            theta.push_back(state.pos.theta.convert(degree));
+          }
+          xv.push_back(state.vel.xv.convert(inch / second));
+          yv.push_back(state.vel.yv.convert(inch / second));
+          angular.push_back(state.vel.angular.convert(degree / second));
+        });
+
+    // The positions don't depend on the estimator, so the reference only
+    // needs working out from the first replay
+    if (first) {
+      if (times.size() < 3) {
+        std::fprintf(stderr, "%s is too short to compare estimators\n", path);
+        return 1;
+      }
+      period = (times.back() - times.front()) / (times.size() - 1);
+      half = std::max<size_t>(1, std::lround(reference_window / period));
+
+      for (size_t i = 1; i < theta.size(); i++) {
+        double turn = std::remainder(theta[i] - theta[i - 1], 360.0);
+        theta[i] = theta[i - 1] + turn;
+      }
+      xv_reference.assign(times.size(), 0.0);
+      yv_reference.assign(times.size(), 0.0);
+      angular_reference.assign(times.size(), 0.0);
+      for (size_t i = half; i + half < times.size(); i++) {
+        xv_reference[i] = centered_slope(times, x, i, half);
+        yv_reference[i] = centered_slope(times, y, i, half);
+        angular_reference[i] = centered_slope(times, theta, i, half);
+      }
+    }
+
+    size_t max_shift = std::lround(max_lag / period);
+    double linear_noise, angular_noise;
+    size_t linear_lag = best_shift({&xv, &yv}, {&xv_reference, &yv_reference},
+                                   half, max_shift, linear_noise);
+    size_t angular_lag = best_shift({&angular}, {&angular_reference}, half,
+                                    max_shift, angular_noise);
+    std::printf("%-16s %14.2f %10.1f %16.2f %10.1f\n", spec.c_str(),
+                linear_noise, linear_lag * period * 1000, angular_noise,
+                angular_lag * period * 1000);
+  }
+  return 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    usage();
+    return 1;
+  }
+
+  // Defaults match the robot in globals.hh
+  QLength longitudinal_diameter = 63.89_mm;
+  QLength lateral_diameter = 63.89_mm;
+  QLength longitudinal_offset = -1.125_in;
+  QLength lateral_offset = -1_in;
+  OdometryIntegrator integrator = OdometryIntegrator::EXPONENTIAL;
+  std::unique_ptr<VelocityEstimator> estimator =
+      std::make_unique<RawVelocity>();
+  HeadingFusionConfig fusion;
+  bool has_drive = false;
+  DriveFallbackConfig drive{3.25_in, 0.75, 12_in};
+  bool trace = false;
+  bool compare = false;
+  std::vector<std::string> estimator_specs;
+
+  for (int i = 2; i < argc; i++) {
+    std::string option = argv[i];
+    if (option == "--trace") {
+      trace = true;
+      continue;
+    }
+    if (option == "--compare-estimators") {
+      compare = true;
+      continue;
+    }
+    if (option == "--no-bias") {
+      fusion.estimate_bias = false;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      usage();
+      return 1;
+    }
+
+    std::string value = argv[++i];
+    if (option == "--integrator") {
+      if (value == "euler")
+        integrator = OdometryIntegrator::EULER;
+      else if (value == "midpoint")
+        integrator = OdometryIntegrator::MIDPOINT;
+      else if (value == "exponential")
+        integrator = OdometryIntegrator::EXPONENTIAL;
+      else {
+        usage();
+        return 1;
+      }
+    } else if (option == "--longitudinal-diameter") {
+      longitudinal_diameter = std::atof(value.c_str()) * millimeter;
+    } else if (option == "--lateral-diameter") {
+      lateral_diameter = std::atof(value.c_str()) * millimeter;
+    } else if (option == "--longitudinal-offset") {
+      longitudinal_offset = std::atof(value.c_str()) * inch;
+    } else if (option == "--lateral-offset") {
+      lateral_offset = std::atof(value.c_str()) * inch;
+    } else if (option == "--inertial-scales") {
+      const char* scale = value.c_str();
+      for (size_t j = 0; j < MAX_INERTIALS && *scale; j++) {
+        fusion.scales[j] = std::atof(scale);
+        scale = std::strchr(scale, ',');
+        if (!scale)
+          break;
+        scale++;
+      }
+    } else if (option == "--drive") {
+      double wheel, ratio, track;
+      if (std::sscanf(value.c_str(), "%lf,%lf,%lf", &wheel, &ratio, &track) !=
+          3) {
+        usage();
+        return 1;
+      }
+      drive.wheel_diameter = wheel * inch;
+      drive.gear_ratio = ratio;
+      drive.track_width = track * inch;
+      has_drive = true;
+    } else if (option == "--estimator") {
+      estimator = parse_estimator(value);
+      if (!estimator) {
+        usage();
+        return 1;
+      }
+      estimator_specs.push_back(value);
+    } else {
+      usage();
+      return 1;
+    }
+  }
+
+  auto make_odometry = [&](const VelocityEstimator& prototype) {
+    auto odometry = std::make_unique<TrackingWheelOdometry>(
+        longitudinal_diameter, lateral_diameter, longitudinal_offset,
+        lateral_offset);
+    odometry->set_integrator(integrator);
+    odometry->set_velocity_estimator(prototype);
+    odometry->set_heading_fusion(fusion);
+    if (has_drive)
+      odometry->set_drive_fallback(drive);
+    return odometry;
+  };
+
+  if (compare) {
+    if (estimator_specs.empty())
+      estimator_specs = {"raw", "ema:0.3", "ls:8", "kalman:20,0.0001"};
+    return compare_estimators(argv[1], estimator_specs, make_odometry);
+  }
+
+  OdometryLogReader log(argv[1]);
+  if (!log.is_open()) {
+    std::fprintf(stderr, "could not read an odometry log from %s\n", argv[1]);
+    return 1;
+  }
+
+  auto odometry = make_odometry(*estimator);
+
+  // Same columns and units as print_telemetry, with time in seconds
+  auto print = [](const OdometrySample& sample, const OdometryState& state) {
+    std::printf("%.6f,%.3f,%.3f,%.2f,%.3f,%.3f,%.2f\n", sample.time * 1e-6,
+                state.pos.x.convert(inch), state.pos.y.convert(inch),
+                state.pos.theta.convert(degree),
+                state.vel.xv.convert(inch / second),
+                state.vel.yv.convert(inch / second),
+                state.vel.angular.convert(degree / second));
+  };
+
+  OdometrySample last{0, 0, 0, 0.0};
+  size_t count = replay_odometry_log(
+      log, *odometry,
+      [&](const OdometrySample& sample, const OdometryState& state) {
+        if (trace)
+          print(sample, state);
+        last = sample;
+      });
+
+  if (!trace)
+    print(last, odometry->get_state());
+  std::fprintf(stderr, "replayed %zu samples, heading std dev %.3f deg\n",
+               count, std::sqrt(odometry->get_heading_variance()));
+  OdometryHealth health = odometry->get_health();
+  if (health.is_degraded() || health.drive != SensorFault::NONE)
+    std::fprintf(stderr,
+                 "faults: longitudinal %s, lateral %s, inertial %s, drive %s\n",
+                 fault_name(health.longitudinal), fault_name(health.lateral),
+                 fault_name(health.inertial), fault_name(health.drive));
+  return 0;
+}
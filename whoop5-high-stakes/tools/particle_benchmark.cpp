@@ -0,0 +1,129 @@
+// Measures the particle filter's step time and accuracy by particle count.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "rev/api/alg/odometry/range_corrected_odometry.hh"
+
+using namespace rev;
+
+namespace {
+const int STEPS = 3000;  // 30 seconds of 10 ms ticks
+const QLength FIELD_WIDTH = 140.4_in;
+
+/**
+ * @brief Odometry which is set from outside, to play the inner odometry
+ *
+ */
+class ScriptedOdometry : public Odometry {
+ public:
+  OdometryState get_state() override { return state; }
+  void set_position(Position pos) override { state.pos = pos; }
+  void reset_position() override { set_position({0_in, 0_in, 0_deg}); }
+
+  OdometryState state{{0_in, 0_in, 0_deg}, {0_mps, 0_mps, 0_deg / second}};
+};
+
+/**
+ * @brief Range along a ray to the inside of a square perimeter centered on
+ * the origin
+ *
+ */
+QLength true_range(const Pose& robot, const Pose& offset) {
+  Pose sensor = offset.to_absolute(robot);
+  double x = sensor.x.convert(meter), y = sensor.y.convert(meter);
+  double dx = std::cos(sensor.theta.convert(radian));
+  double dy = std::sin(sensor.theta.convert(radian));
+  double half = FIELD_WIDTH.convert(meter) / 2;
+
+  double range = INFINITY;
+  if (dx > 0)
+    range = std::min(range, (half - x) / dx);
+  if (dx < 0)
+    range = std::min(range, (-half - x) / dx);
+  if (dy > 0)
+    range = std::min(range, (half - y) / dy);
+  if (dy < 0)
+    range = std::min(range, (-half - y) / dy);
+  return range * meter;
+}
+
+struct Result {
+  double step_us;
+  double weigh_us;
+  QLength final_error;
+  QLength odometry_error;
+};
+
+Result run(size_t particles) {
+  // Front facing sensor, and one facing left
+  const std::vector<Pose> offsets{{4_in, 0_in, 0_deg},
+                                  {0_in, -5_in, -90_deg}};
+  std::mt19937 random(1);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+  auto odometry = std::make_shared<ScriptedOdometry>();
+  Pose truth{-30_in, 0_in, 0_deg};
+  odometry->set_position(truth);
+
+  ParticleConfig config;
+  config.particles = particles;
+  RangeCorrectedOdometry filter(odometry, FieldWalls::perimeter(FIELD_WIDTH),
+                                offsets, config);
+
+  std::vector<QLength> ranges(offsets.size(), 0_m);
+  double total = 0, weighing = 0;
+  int weighing_steps = 0;
+  for (int step = 0; step < STEPS; step++) {
+    // Circles of 30 in radius at 40 in/s, with the odometry reading 2% long
+    // and gaining heading error
+    Pose motion{0.4_in, 0_in, 0.4 / 30 * radian};
+    truth = motion.to_absolute(truth);
+    Pose measured{motion.x * 1.02, motion.y, motion.theta * 1.01};
+    odometry->state.pos = measured.to_absolute(odometry->state.pos);
+
+    bool due = filter.is_update_due();
+    if (due) {
+      for (size_t i = 0; i < offsets.size(); i++) {
+        ranges[i] = true_range(truth, offsets[i]) + noise(random) * 15_mm;
+        if (uniform(random) < 0.05)
+          ranges[i] *= 0.5;
+      }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    filter.update(due ? ranges.data() : nullptr);
+    double elapsed = std::chrono::duration<double, std::micro>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    total += elapsed;
+    if (due) {
+      weighing += elapsed;
+      weighing_steps++;
+    }
+  }
+
+  return {total / STEPS, weighing / std::max(weighing_steps, 1),
+          abs(filter.get_state().pos - truth),
+          abs(odometry->state.pos - truth)};
+}
+}  // namespace
+
+int main() {
+  std::printf("%10s %14s %16s %16s %18s\n", "particles", "step (us)",
+              "weigh step (us)", "final err (in)", "odometry err (in)");
+  for (size_t particles : {100, 300, 500, 2000}) {
+    Result result = run(particles);
+    std::printf("%10zu %14.1f %16.1f %16.2f %18.2f\n", particles,
+                result.step_us, result.weigh_us,
+                result.final_error.convert(inch),
+                result.odometry_error.convert(inch));
+  }
+  return 0;
+}
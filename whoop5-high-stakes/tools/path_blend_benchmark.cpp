@@ -0,0 +1,107 @@
+// Measures a route's time stopping at each waypoint against blending.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+#include "rev/api/alg/drive/correction/pilons_correction.hh"
+#include "rev/api/alg/drive/motion/cascading_motion.hh"
+#include "rev/api/alg/drive/stop/simple_stop.hh"
+#include "rev/api/alg/reckless/reckless.hh"
+#include "rev/api/async/clock.hh"
+#include "rev/api/hardware/chassis_sim/driftless_sim.hh"
+
+using namespace rev;
+
+namespace {
+const QTime TIMESTEP = 10_ms;
+const QTime TIME_LIMIT = 30_s;
+
+struct RunResult {
+  QTime time;
+  QLength final_error;
+  // Slowest the robot went through the waypoints before the last, from
+  // halfway along the first segment to the start of the last
+  QSpeed slowest;
+};
+
+RecklessPath route() {
+  const Position waypoints[] = {{24_in, 0_in, 0_deg},  {48_in, 12_in, 0_deg},
+                                {72_in, 0_in, 0_deg},  {96_in, -12_in, 0_deg},
+                                {120_in, 0_in, 0_deg}, {144_in, 12_in, 0_deg}};
+
+  RecklessPath path;
+  for (const Position& waypoint : waypoints)
+    path.with_segment(RecklessPathSegment(
+        CascadingMotion(1.0, 0.02, 1.0 / 60), PilonsCorrection(4, 0.5_in),
+        SimpleStop(0.03_s, 0.15_s, 0.3), waypoint));
+  return path;
+}
+
+RunResult run(QLength blend_distance) {
+  auto clock = std::make_shared<VirtualClock>();
+  set_clock(clock);
+
+  // Roughly a 450rpm drive on 3.25" wheels with a 12" track
+  auto sim = std::make_shared<DriftlessSim>(60 * inch / second,
+                                            10 * radian / second, 6_Hz, 8_Hz,
+                                            20_Hz, 20_Hz);
+  auto reckless = std::make_shared<Reckless>(sim, sim);
+
+  RecklessPath path = route();
+  Position end = path.segments.at(path.segments.size() - 1).target_point;
+  reckless->go(path.with_blending(blend_distance));
+
+  RunResult result{0_s, 0_in, 1000 * inch / second};
+  while (!reckless->is_completed() && result.time < TIME_LIMIT) {
+    clock->advance(TIMESTEP);
+    result.time += TIMESTEP;
+    sim->step();
+    reckless->step();
+
+    OdometryState state = sim->get_state();
+    QSpeed speed =
+        sqrt(state.vel.xv * state.vel.xv + state.vel.yv * state.vel.yv);
+    double progress = reckless->progress();
+    if (progress >= 0.5 && progress < path.segments.size() - 1)
+      result.slowest = std::min(result.slowest, speed);
+  }
+
+  // Let the robot come to rest before measuring where it ended up
+  for (int i = 0; i < 100; i++) {
+    clock->advance(TIMESTEP);
+    sim->step();
+  }
+  result.final_error = abs(sim->get_state().pos - end);
+
+  set_clock(nullptr);
+  return result;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  QLength blend_distance = 8_in;
+  if (argc > 1)
+    blend_distance = std::atof(argv[1]) * inch;
+
+  // Reckless reports each state change, which would bury the results
+  std::stringstream discard;
+  std::streambuf* cout_buffer = std::cout.rdbuf(discard.rdbuf());
+  RunResult stopping = run(0_in);
+  RunResult blended = run(blend_distance);
+  std::cout.rdbuf(cout_buffer);
+
+  std::printf("%-28s %8s %14s %16s\n", "", "time (s)", "final err (in)",
+              "slowest (in/s)");
+  std::printf("%-28s %8.2f %14.2f %16.1f\n", "stopping at each waypoint",
+              stopping.time.convert(second),
+              stopping.final_error.convert(inch),
+              stopping.slowest.convert(inch / second));
+  std::printf("blended over %-15.1f %8.2f %14.2f %16.1f\n",
+              blend_distance.convert(inch), blended.time.convert(second),
+              blended.final_error.convert(inch),
+              blended.slowest.convert(inch / second));
+  return 0;
+}
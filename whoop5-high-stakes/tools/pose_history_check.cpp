@@ -0,0 +1,158 @@
+// Checks PoseHistory lookups, window edges, wraparound and torn reads.
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "rev/api/alg/odometry/pose_history.hh"
+
+using namespace rev;
+
+namespace {
+const int READERS = 4;
+const auto STRESS_TIME = std::chrono::seconds(2);
+
+// Everything is a different multiple of n, so a state made from two torn
+// records, or interpolated wrongly, can't pass on_line()
+OdometryState make_state(double n) {
+  return {{n * inch, -2 * n * inch, 0_deg},
+          {4 * n * inch / second, -5 * n * inch / second,
+           0 * radian / second}};
+}
+
+bool on_line(const OdometryState& state, double n) {
+  const double tolerance = 1e-6 * (1 + std::abs(n));
+  return std::abs(state.pos.x.convert(inch) - n) < tolerance &&
+         std::abs(state.pos.y.convert(inch) + 2 * n) < tolerance &&
+         std::abs(state.vel.xv.convert(inch / second) - 4 * n) < 4 * tolerance &&
+         std::abs(state.vel.yv.convert(inch / second) + 5 * n) < 5 * tolerance;
+}
+
+bool failed = false;
+
+void expect(bool condition, const char* what) {
+  std::printf("%-48s %s\n", what, condition ? "ok" : "FAILED");
+  failed = failed || !condition;
+}
+
+/**
+ * @brief Checks a time gives the state on the line, or is out of the window
+ *
+ */
+template <size_t N>
+bool at(const PoseHistory<N>& history, uint64_t time, double n) {
+  OdometryState state;
+  return history.state_at(time, state) && on_line(state, n);
+}
+
+template <size_t N>
+bool missing(const PoseHistory<N>& history, uint64_t time) {
+  OdometryState state;
+  return !history.state_at(time, state);
+}
+
+void check_single_thread() {
+  PoseHistory<16> history;
+  expect(missing(history, 0) && history.size() == 0,
+         "empty history has nothing");
+
+  // One record every 10ms, with n counting milliseconds
+  for (int i = 1; i <= 5; i++)
+    history.record(i * 10000, make_state(i * 10));
+  expect(history.size() == 5, "size counts records");
+  expect(at(history, 10000, 10) && at(history, 50000, 50),
+         "oldest and newest times are exact");
+  expect(at(history, 25000, 25) && at(history, 12500, 12.5) &&
+             at(history, 49000, 49),
+         "times between records interpolate");
+  expect(missing(history, 9999), "before the oldest is out of the window");
+  expect(at(history, 90000, 50), "after the newest gives the newest");
+
+  history.record(50000, make_state(60));
+  expect(history.size() == 5 && at(history, 50000, 60) &&
+             at(history, 45000, 50),
+         "a later state for the same time replaces it");
+  history.record(50000, make_state(50));
+
+  // Around the ring many times, so the oldest kept has been overwritten
+  for (int i = 6; i <= 200; i++)
+    history.record(i * 10000, make_state(i * 10));
+  expect(history.size() == 16, "size stops at the capacity");
+  expect(missing(history, 1840000) && at(history, 1850000, 1850),
+         "after wrapping the window starts 16 back");
+  expect(at(history, 1855000, 1855) && at(history, 1995000, 1995) &&
+             at(history, 1922500, 1922.5),
+         "after wrapping times between records interpolate");
+
+  history.clear();
+  expect(history.size() == 0 && missing(history, 2000000),
+         "clear forgets everything");
+  history.record(2010000, make_state(7));
+  expect(history.size() == 1 && missing(history, 2000000) &&
+             at(history, 2010000, 7) && at(history, 3000000, 7),
+         "records after clear start a new window");
+}
+
+/**
+ * @brief One writer records as fast as it can while readers look up times in
+ * the window, each of which must land on the line
+ *
+ */
+void check_concurrent() {
+  PoseHistory<128> history;
+  std::atomic<bool> done{false};
+  std::atomic<uint64_t> newest{0};
+  std::atomic<long> reads{0}, bad{0}, misses{0};
+
+  std::vector<std::thread> readers;
+  for (int r = 0; r < READERS; r++) {
+    readers.emplace_back([&, r] {
+      std::mt19937 random(r);
+      while (!done.load(std::memory_order_relaxed)) {
+        uint64_t last = newest.load(std::memory_order_acquire);
+        if (last < 1000)
+          continue;
+        // Mostly inside the window, sometimes just past the oldest kept.
+        // The writer has always recorded the time read, so none are later
+        // than the newest.
+        uint64_t time = last - random() % (140 * 10);
+        OdometryState state;
+        if (!history.state_at(time, state))
+          misses++;
+        else if (!on_line(state, time / 10.0))
+          bad++;
+        reads++;
+      }
+    });
+  }
+
+  long records = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t time = 10;
+       std::chrono::steady_clock::now() - start < STRESS_TIME; time += 10) {
+    history.record(time, make_state(time / 10.0));
+    newest.store(time, std::memory_order_release);
+    records++;
+  }
+  done = true;
+  for (std::thread& reader : readers)
+    reader.join();
+
+  std::printf("\n%ld records, %ld reads by %d readers, %ld out of the window\n",
+              records, reads.load(), READERS, misses.load());
+  expect(bad == 0, "no reader got a torn or misplaced state");
+  expect(reads > misses, "readers found most times");
+}
+}  // namespace
+
+int main() {
+  check_single_thread();
+  check_concurrent();
+  if (failed)
+    std::printf("\nthe history did not give the states recorded\n");
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+// Measures CascadingMotion against ProfiledMotion on straight segments.
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+#include "rev/api/alg/drive/correction/pilons_correction.hh"
+#include "rev/api/alg/drive/motion/cascading_motion.hh"
+#include "rev/api/alg/drive/motion/profiled_motion.hh"
+#include "rev/api/alg/drive/stop/simple_stop.hh"
+#include "rev/api/alg/reckless/reckless.hh"
+#include "rev/api/async/clock.hh"
+#include "rev/api/hardware/chassis_sim/driftless_sim.hh"
+
+using namespace rev;
+
+namespace {
+const QTime TIMESTEP = 10_ms;
+const QTime TIME_LIMIT = 10_s;
+
+struct RunResult {
+  QTime time;
+  QLength overshoot;    // Furthest past the target
+  QLength final_error;  // Along the segment, once the robot has stopped
+  QAcceleration peak_acceleration;  // Speeding up, so not counting braking
+};
+
+RunResult run(MotionStrategy motion, StopStrategy stop, QLength length) {
+  auto clock = std::make_shared<VirtualClock>();
+  set_clock(clock);
+
+  // Roughly a 450rpm drive on 3.25" wheels with a 12" track
+  auto sim = std::make_shared<DriftlessSim>(60 * inch / second,
+                                            10 * radian / second, 6_Hz, 8_Hz,
+                                            20_Hz, 20_Hz);
+  auto reckless = std::make_shared<Reckless>(sim, sim);
+
+  reckless->go(RecklessPath().with_segment(RecklessPathSegment(
+      motion, PilonsCorrection(4, 0.5_in), stop,
+      {length, 0_in, 0_deg})));
+
+  RunResult result{0_s, 0_in, 0_in, 0_mps2};
+  QSpeed v_last = 0_mps;
+  auto measure = [&]() {
+    OdometryState state = sim->get_state();
+    result.overshoot = std::max(result.overshoot, state.pos.x - length);
+    result.peak_acceleration = std::max(result.peak_acceleration,
+                                        (state.vel.xv - v_last) / TIMESTEP);
+    v_last = state.vel.xv;
+  };
+
+  while (!reckless->is_completed() && result.time < TIME_LIMIT) {
+    clock->advance(TIMESTEP);
+    result.time += TIMESTEP;
+    sim->step();
+    reckless->step();
+    measure();
+  }
+
+  // Let the robot come to rest
+  for (int i = 0; i < 100; i++) {
+    clock->advance(TIMESTEP);
+    sim->step();
+    measure();
+  }
+  result.final_error = sim->get_state().pos.x - length;
+
+  set_clock(nullptr);
+  return result;
+}
+
+void print(const char* name, QLength length, const RunResult& result) {
+  std::printf("%-12s %6.0f %8.2f %13.2f %15.2f %17.0f\n", name,
+              length.convert(inch), result.time.convert(second),
+              result.overshoot.convert(inch), result.final_error.convert(inch),
+              result.peak_acceleration.convert(inch / (second * second)));
+}
+}  // namespace
+
+int main() {
+  // Reckless reports each state change, which would bury the results
+  std::stringstream discard;
+  std::streambuf* cout_buffer = std::cout.rdbuf(discard.rdbuf());
+
+  const QLength lengths[] = {6_in, 12_in, 24_in, 48_in, 96_in};
+  RunResult cascading[5];
+  RunResult profiled[5];
+  for (int i = 0; i < 5; i++) {
+    cascading[i] = run(CascadingMotion(1.0, 0.02, 1.0 / 60),
+                       SimpleStop(0.03_s, 0.15_s, 0.3), lengths[i]);
+    // k_v is one over the top speed, and k_a is k_v over the sim's 6Hz
+    // response. The profile slows the robot down itself, so the stop only
+    // coasts for the last moment.
+    profiled[i] = run(ProfiledMotion(1.0, 50 * inch / second,
+                                     120 * inch / (second * second), 1.0 / 60,
+                                     1.0 / 360, 0.05, 0.01),
+                      SimpleStop(0.03_s, 0.05_s, 0.1), lengths[i]);
+  }
+  std::cout.rdbuf(cout_buffer);
+
+  std::printf("%-12s %6s %8s %13s %15s %17s\n", "motion", "length", "time (s)",
+              "overshoot (in)", "final error (in)", "peak accel (in/s2)");
+  for (int i = 0; i < 5; i++) {
+    print("cascading", lengths[i], cascading[i]);
+    print("profiled", lengths[i], profiled[i]);
+  }
+  return 0;
+}
@@ -0,0 +1,238 @@
+// Checks when progress triggers fire, and measures their cost per step.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "rev/api/alg/reckless/reckless.hh"
+#include "rev/api/async/clock.hh"
+#include "rev/api/hardware/chassis_sim/driftless_sim.hh"
+
+using namespace rev;
+
+namespace {
+const QTime TIMESTEP = 10_ms;
+const int MAX_TICKS = 3000;
+const int TIMED_STEPS = 200000;
+const int ROUNDS = 10;
+
+struct Trigger {
+  size_t segment;
+  double progress;
+  std::vector<int> fired_ticks;  // Every tick it ran on, over all runs
+};
+
+RecklessPathSegment make_segment(Position target) {
+  return RecklessPathSegment(
+      CascadingMotion(1.0, 0.02, 1.0 / 60), PilonsCorrection(4.0, 0.5_in),
+      SimpleStop(0.03_s, 0.15_s, 0.3), target, 1_in);
+}
+
+// The segment a tick followed and how far along it the robot was
+struct Tick {
+  size_t segment;
+  double progress;
+};
+
+/**
+ * @brief Finds the tick a trigger should have run on
+ *
+ * That is the first tick of its segment at or past its progress, or if there
+ * is none, the last tick of its segment, when the segment ended short.
+ */
+int expected_tick(const Trigger& trigger, const std::vector<Tick>& ticks) {
+  int last = -1;
+  for (size_t i = 0; i < ticks.size(); i++) {
+    if (ticks[i].segment != trigger.segment)
+      continue;
+    if (ticks[i].progress >= trigger.progress)
+      return i;
+    last = i;
+  }
+  return last;
+}
+
+/**
+ * @brief Drives a path to the end, recording each tick
+ *
+ * The segment is taken from the telemetry, which records the segment each
+ * step followed, since progress() alone can't tell overshooting the end of
+ * one segment from the next segment.
+ */
+std::vector<Tick> drive(Reckless& reckless,
+                        DriftlessSim& sim,
+                        VirtualClock& clock,
+                        TelemetryRing& telemetry,
+                        const RecklessPath& path,
+                        int& tick) {
+  std::vector<Tick> ticks;
+  sim.set_position({0_in, 0_in, 0_deg});
+  reckless.go(path);
+  for (tick = 0; !reckless.is_completed() && tick < MAX_TICKS; tick++) {
+    clock.advance(TIMESTEP);
+    sim.step();
+    reckless.step();
+
+    // The last step only notices the path is done, and records nothing
+    TelemetryRecord record;
+    if (telemetry.pop(record))
+      ticks.push_back({record.segment, reckless.progress() - record.segment});
+  }
+  return ticks;
+}
+
+/**
+ * @brief Drives paths whose triggers break out, and start another path, from
+ * inside Reckless::step(), checking each takes effect and no other trigger is
+ * lost or run twice
+ *
+ */
+bool check_reentry(Reckless& reckless, DriftlessSim& sim, VirtualClock& clock) {
+  auto drive_to_end = [&] {
+    for (int tick = 0; !reckless.is_completed() && tick < MAX_TICKS; tick++) {
+      clock.advance(TIMESTEP);
+      sim.step();
+      reckless.step();
+    }
+  };
+
+  int before = 0, after = 0;
+  RecklessPathSegment stopping = make_segment({48_in, 0_in, 0_deg});
+  stopping.with_trigger(0.5, [&] { before++; })
+      .with_trigger(0.5, [&] { reckless.breakout(); })
+      .with_trigger(0.5, [&] { after++; });
+  RecklessPath stopped;
+  stopped.with_segment(stopping).with_segment(make_segment({96_in, 0_in, 0_deg}));
+  sim.set_position({0_in, 0_in, 0_deg});
+  reckless.go(stopped);
+  drive_to_end();
+  bool broke_out = reckless.is_completed() && before == 1 && after == 1 &&
+                   sim.get_state().pos.x < 48_in;
+
+  int replaced = 0, followed = 0;
+  RecklessPathSegment onward = make_segment({96_in, 0_in, 0_deg});
+  onward.with_trigger(0.5, [&] { followed++; });
+  RecklessPath next;
+  next.with_segment(onward);
+  RecklessPathSegment replacing = make_segment({48_in, 0_in, 0_deg});
+  // Counting after go() touches the action once its path is replaced
+  replacing.with_trigger(0.25, [&] {
+    reckless.go(next);
+    replaced++;
+  });
+  RecklessPath first;
+  first.with_segment(replacing);
+  sim.set_position({0_in, 0_in, 0_deg});
+  reckless.go(first);
+  drive_to_end();
+  bool went_on = reckless.is_completed() && replaced == 1 && followed == 1 &&
+                 abs(sim.get_state().pos.x - 96_in) < 2_in;
+
+  std::printf("\nbreakout from a trigger %s, go from a trigger %s\n",
+              broke_out ? "ok" : "wrong", went_on ? "ok" : "wrong");
+  return broke_out && went_on;
+}
+
+/**
+ * @brief Times steps along a segment too long to finish, with some number of
+ * triggers which are never reached
+ *
+ */
+double time_steps(Reckless& reckless, DriftlessSim& sim, size_t triggers) {
+  int fired = 0;
+  RecklessPathSegment segment = make_segment({100000_in, 0_in, 0_deg});
+  for (size_t i = 0; i < triggers; i++)
+    segment.with_trigger(0.9, [&] { fired++; });
+  RecklessPath path;
+  path.with_segment(segment);
+
+  sim.set_position({0_in, 0_in, 0_deg});
+  reckless.go(path);
+  double best = INFINITY;
+  for (int round = 0; round < ROUNDS; round++) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < TIMED_STEPS; i++)
+      reckless.step();
+    double elapsed = std::chrono::duration<double, std::nano>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    best = std::min(best, elapsed / TIMED_STEPS);
+  }
+  reckless.breakout();
+  if (fired)
+    std::printf("a trigger which was never reached fired\n");
+  return fired ? INFINITY : best;
+}
+}  // namespace
+
+int main() {
+  auto clock = std::make_shared<VirtualClock>();
+  set_clock(clock);
+  auto sim = std::make_shared<DriftlessSim>(60 * inch / second,
+                                            10 * radian / second, 6_Hz, 8_Hz,
+                                            20_Hz, 20_Hz);
+  Reckless reckless(sim, sim);
+  auto telemetry = std::make_shared<TelemetryRing>();
+  reckless.set_telemetry(telemetry);
+
+  // The drop point keeps the first segment short of 1, so that trigger runs
+  // as the segment ends
+  std::vector<Trigger> triggers{
+      {0, 0.0, {}}, {0, 0.25, {}}, {0, 0.6, {}}, {0, 1.0, {}}, {1, 0.5, {}}};
+  int tick = 0;
+  RecklessPathSegment first = make_segment({48_in, 0_in, 0_deg});
+  RecklessPathSegment second = make_segment({96_in, 0_in, 0_deg});
+  for (Trigger& trigger : triggers)
+    (trigger.segment == 0 ? first : second)
+        .with_trigger(trigger.progress,
+                      [&] { trigger.fired_ticks.push_back(tick); });
+  RecklessPath path;
+  path.with_segment(first).with_segment(second);
+
+  // Reckless reports each state change, which would bury the results
+  std::stringstream discard;
+  std::streambuf* cout_buffer = std::cout.rdbuf(discard.rdbuf());
+
+  // The path is copied into the controller each time, so the triggers are
+  // armed again for the second run
+  bool ok = true;
+  std::printf("%-8s %9s %12s %12s %10s\n", "segment", "progress", "fired tick",
+              "expected", "run");
+  for (int run = 1; run <= 2; run++) {
+    for (Trigger& trigger : triggers)
+      trigger.fired_ticks.clear();
+    std::vector<Tick> ticks =
+        drive(reckless, *sim, *clock, *telemetry, path, tick);
+    ok = ok && reckless.is_completed();
+
+    for (const Trigger& trigger : triggers) {
+      int expected = expected_tick(trigger, ticks);
+      bool on_time =
+          trigger.fired_ticks.size() == 1 && trigger.fired_ticks[0] == expected;
+      ok = ok && on_time;
+      std::printf("%-8zu %9.2f %12d %12d %10d%s\n", trigger.segment,
+                  trigger.progress,
+                  trigger.fired_ticks.empty() ? -1 : trigger.fired_ticks[0],
+                  expected, run, on_time ? "" : "  wrong");
+    }
+  }
+
+  reckless.set_telemetry(nullptr);
+  ok = check_reentry(reckless, *sim, *clock) && ok;
+  double none = time_steps(reckless, *sim, 0);
+  double pending = time_steps(reckless, *sim, MAX_SEGMENT_TRIGGERS);
+  std::cout.rdbuf(cout_buffer);
+  set_clock(nullptr);
+
+  std::printf("\nstep with no triggers %.1f ns, with %zu pending %.1f ns\n",
+              none, MAX_SEGMENT_TRIGGERS, pending);
+  ok = ok && std::isfinite(none) && std::isfinite(pending);
+  if (!ok)
+    std::printf("the triggers did not each fire once on the right tick\n");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,256 @@
+// Measures RamseteFollower's end error, and what k_a and k_s each add.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "rev/api/alg/trajectory/ramsete_follower.hh"
+#include "rev/api/async/clock.hh"
+#include "rev/api/hardware/chassis_sim/driftless_sim.hh"
+
+using namespace rev;
+
+namespace {
+const QTime TIMESTEP = 10_ms;
+const int MAX_TICKS = 1000;
+// Ticks left after the trajectory ends for the robot to coast to a stop
+const int SETTLE_TICKS = 100;
+
+// The path, in meters
+const double STRAIGHT = 24 * 0.0254;
+const double RADIUS = 24 * 0.0254;
+const double ARC = M_PI / 2 * RADIUS;
+const double LENGTH = 2 * STRAIGHT + ARC;
+const double MAX_V = 40 * 0.0254;
+const double MAX_A = 60 * 0.0254;
+
+// The sim's full speeds give a 12 inch track, and its speeds approach their
+// targets at 6 Hz, so a power of 1 / (6 * 60) per in/s^2 keeps up
+const QSpeed SIM_MAX_SPEED = 60 * inch / second;
+const QLength TRACK_WIDTH = 12_in;
+const double SIM_K_A = 1.0 / (6 * 60);
+// Power friction takes from each side
+const double FRICTION = 0.1;
+
+bool failed = false;
+
+void expect(bool condition, const char* what) {
+  std::printf("%-56s %s\n", what, condition ? "ok" : "FAILED");
+  failed = failed || !condition;
+}
+
+/**
+ * @brief Passes powers through to the sim less the power friction takes,
+ * which works against the way each side is turning, or holds it still until
+ * the power overcomes it
+ *
+ */
+class FrictionChassis : public Chassis {
+ public:
+  explicit FrictionChassis(std::shared_ptr<DriftlessSim> isim) : sim(isim) {}
+
+  void drive_tank(double left, double right) override {
+    OdometryState state = sim->get_state();
+    QSpeed v = cos(state.pos.theta).get_value() * state.vel.xv +
+               sin(state.pos.theta).get_value() * state.vel.yv;
+    QSpeed w = state.vel.angular.convert(radian / second) * TRACK_WIDTH / 2 /
+               second;
+    sim->drive_tank(resist(left, v + w), resist(right, v - w));
+  }
+  void drive_arcade(double forward, double yaw) override {
+    sim->drive_arcade(forward, yaw);
+  }
+  void set_brake_harsh() override { sim->set_brake_harsh(); }
+  void set_brake_coast() override { sim->set_brake_coast(); }
+  void stop() override { sim->stop(); }
+
+ private:
+  static double resist(double power, QSpeed speed) {
+    if (abs(speed) > 0.1 * inch / second)
+      return power - std::copysign(FRICTION, speed.get_value());
+    return std::copysign(std::max(0.0, std::abs(power) - FRICTION), power);
+  }
+
+  std::shared_ptr<DriftlessSim> sim;
+};
+
+/**
+ * @brief Lays out the path on a trapezoidal profile, turning clockwise
+ *
+ * This stands in for squiggles' generator, which only builds for the brain.
+ * In reverse the robot backs along the path mirrored through the start,
+ * facing the same way it would going forwards.
+ */
+std::vector<squiggles::ProfilePoint> make_trajectory(bool reverse) {
+  double accel_time = MAX_V / MAX_A;
+  double accel_distance = MAX_V * accel_time / 2;
+  double duration = 2 * accel_time + (LENGTH - 2 * accel_distance) / MAX_V;
+  double direction = reverse ? -1 : 1;
+
+  std::vector<squiggles::ProfilePoint> trajectory;
+  int points = static_cast<int>(std::ceil(duration / 0.01));
+  for (int i = 0; i <= points; i++) {
+    double t = std::min(i * 0.01, duration);
+    double s, v, a;
+    if (t < accel_time) {
+      s = MAX_A * t * t / 2;
+      v = MAX_A * t;
+      a = MAX_A;
+    } else if (t < duration - accel_time) {
+      s = accel_distance + MAX_V * (t - accel_time);
+      v = MAX_V;
+      a = 0;
+    } else {
+      double left = duration - t;
+      s = LENGTH - MAX_A * left * left / 2;
+      v = MAX_A * left;
+      a = -MAX_A;
+    }
+
+    double x, y, yaw, curvature = 0;
+    if (s < STRAIGHT) {
+      x = s;
+      y = 0;
+      yaw = 0;
+    } else if (s < STRAIGHT + ARC) {
+      yaw = (s - STRAIGHT) / RADIUS;
+      x = STRAIGHT + RADIUS * std::sin(yaw);
+      y = RADIUS * (1 - std::cos(yaw));
+      curvature = 1 / RADIUS;
+    } else {
+      x = STRAIGHT + RADIUS;
+      y = RADIUS + s - STRAIGHT - ARC;
+      yaw = M_PI / 2;
+    }
+    trajectory.emplace_back(
+        squiggles::ControlVector(
+            squiggles::Pose(direction * x, direction * y, yaw),
+            direction * v, direction * a),
+        std::vector<double>{0, 0}, direction * curvature, t);
+  }
+  return trajectory;
+}
+
+struct Result {
+  double position_error;  // Inches from the end of the path
+  double heading_error;   // Degrees
+  double max_error;       // Inches from where the trajectory was, on the way
+};
+
+/**
+ * @brief Follows a trajectory and lets the robot coast to a stop
+ *
+ */
+Result follow(const std::vector<squiggles::ProfilePoint>& trajectory,
+              RamseteConfig config,
+              Position start,
+              bool friction) {
+  auto clock = std::make_shared<VirtualClock>();
+  set_clock(clock);
+  auto sim = std::make_shared<DriftlessSim>(SIM_MAX_SPEED,
+                                            10 * radian / second, 6_Hz, 8_Hz,
+                                            20_Hz, 20_Hz);
+  sim->set_position(start);
+  std::shared_ptr<Chassis> chassis = sim;
+  if (friction)
+    chassis = std::make_shared<FrictionChassis>(sim);
+  RamseteFollower follower(chassis, sim, config);
+
+  Result result{0, 0, 0};
+  follower.follow(trajectory);
+  for (int tick = 0; !follower.is_completed() && tick < MAX_TICKS; tick++) {
+    clock->advance(TIMESTEP);
+    sim->step();
+    follower.step();
+
+    // The follower samples the trajectory from its first step, and the sim
+    // moves on its power from the next
+    size_t i = std::min<size_t>(tick, trajectory.size() - 1);
+    Position pos = sim->get_state().pos;
+    const squiggles::Pose& reference = trajectory[i].vector.pose;
+    result.max_error = std::max(
+        result.max_error, std::hypot(pos.x.convert(meter) - reference.x,
+                                     pos.y.convert(meter) - reference.y) /
+                              0.0254);
+  }
+  for (int tick = 0; tick < SETTLE_TICKS; tick++) {
+    clock->advance(TIMESTEP);
+    sim->step();
+  }
+  set_clock(nullptr);
+
+  Position pos = sim->get_state().pos;
+  const squiggles::Pose& end = trajectory.back().vector.pose;
+  result.position_error = std::hypot(pos.x.convert(meter) - end.x,
+                                     pos.y.convert(meter) - end.y) /
+                          0.0254;
+  result.heading_error = (pos.theta.convert(radian) - end.yaw) * 180 / M_PI;
+  return result;
+}
+
+void print(const char* name, const Result& result) {
+  std::printf("%-24s %12.2f %12.2f %12.2f\n", name, result.position_error,
+              result.heading_error, result.max_error);
+}
+}  // namespace
+
+int main() {
+  // b is per square meter, so paths a few feet long want it well above the
+  // usual 2. At 2 the step into the arc, which the sim can't turn into at
+  // once, leaves the robot about 2 in off when the time runs out.
+  RamseteConfig config{TRACK_WIDTH, SIM_MAX_SPEED};
+  config.b = 20;
+  config.zeta = 0.9;
+  config.k_a = SIM_K_A;
+  RamseteConfig no_feedback = config;
+  no_feedback.b = 0;
+  no_feedback.zeta = 0;
+  RamseteConfig no_k_a = config;
+  no_k_a.k_a = 0;
+  RamseteConfig with_k_s = config;
+  with_k_s.k_s = FRICTION;
+
+  const Position origin{0_in, 0_in, 0_deg};
+  auto forwards = make_trajectory(false);
+  auto backwards = make_trajectory(true);
+
+  Result open_loop = follow(forwards, no_feedback, origin, false);
+  Result closed = follow(forwards, config, origin, false);
+  Result reverse = follow(backwards, config, origin, false);
+  Result offset = follow(forwards, config, {0_in, 3_in, 10_deg}, false);
+  Result without_k_a = follow(forwards, no_k_a, origin, false);
+  Result friction = follow(forwards, config, origin, true);
+  Result friction_k_s = follow(forwards, with_k_s, origin, true);
+
+  std::printf("%-24s %12s %12s %12s\n", "run", "end (in)", "heading (deg)",
+              "worst (in)");
+  print("feedforward only", open_loop);
+  print("RAMSETE", closed);
+  print("RAMSETE in reverse", reverse);
+  print("RAMSETE from 3 in off", offset);
+  print("RAMSETE without k_a", without_k_a);
+  print("friction without k_s", friction);
+  print("friction with k_s", friction_k_s);
+  std::printf("\n");
+
+  auto close = [](const Result& result) {
+    return result.position_error < 1.0 && std::abs(result.heading_error) < 5;
+  };
+  expect(close(closed), "RAMSETE ends within 1 in and 5 deg");
+  expect(close(reverse) &&
+             std::abs(reverse.position_error - closed.position_error) < 0.01,
+         "in reverse it ends the same");
+  expect(close(offset), "from off the start it closes the gap");
+  expect(closed.max_error < open_loop.max_error,
+         "feedback follows closer than feedforward alone");
+  expect(without_k_a.max_error > closed.max_error,
+         "k_a keeps the robot from lagging the trajectory");
+  expect(close(friction_k_s) && friction.max_error > friction_k_s.max_error,
+         "k_s makes up for friction");
+
+  if (failed)
+    std::printf("\nthe follower did not track the trajectory\n");
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,150 @@
+// Finds the Reckless strategy settings which drive a route fastest.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "rev/api/alg/drive/correction/pilons_correction.hh"
+#include "rev/api/alg/drive/motion/cascading_motion.hh"
+#include "rev/api/alg/drive/stop/simple_stop.hh"
+#include "rev/api/alg/reckless/reckless.hh"
+#include "rev/api/async/clock.hh"
+#include "rev/api/hardware/chassis_sim/driftless_sim.hh"
+
+using namespace rev;
+
+namespace {
+const QTime TIMESTEP = 10_ms;
+const QTime TIME_LIMIT = 30_s;
+
+struct Settings {
+  double k_v;
+  double k_correction;
+  QTime harsh_threshold;
+  QTime coast_threshold;
+  double coast_power;
+};
+
+struct RunResult {
+  Settings settings;
+  QTime time;
+  QLength final_error;
+  bool completed;
+
+  // Each inch off the final point costs as much as half a second
+  double score() const {
+    return time.convert(second) + 0.5 * final_error.convert(inch);
+  }
+};
+
+RunResult run(const Settings& settings) {
+  auto clock = std::make_shared<VirtualClock>();
+  set_clock(clock);
+
+  // Roughly a 450rpm drive on 3.25" wheels with a 12" track
+  auto sim = std::make_shared<DriftlessSim>(60 * inch / second,
+                                            10 * radian / second, 6_Hz, 8_Hz,
+                                            20_Hz, 20_Hz);
+  auto reckless = std::make_shared<Reckless>(sim, sim);
+
+  // Out and back across the field and up and down a column, about as long as
+  // an autonomous skills route at one stop per waypoint
+  const Position waypoints[] = {
+      {48_in, 0_in, 0_deg},   {48_in, 24_in, 0_deg},  {0_in, 24_in, 0_deg},
+      {0_in, 48_in, 0_deg},   {48_in, 48_in, 0_deg},  {72_in, 24_in, 0_deg},
+      {24_in, 0_in, 0_deg},   {24_in, 36_in, 0_deg},  {60_in, 36_in, 0_deg},
+      {60_in, 0_in, 0_deg},   {12_in, 12_in, 0_deg},  {0_in, 0_in, 0_deg}};
+
+  RecklessPath path;
+  for (const Position& waypoint : waypoints)
+    path.with_segment(RecklessPathSegment(
+        CascadingMotion(1.0, 0.02, 1.0 / 60, 60 * inch / second,
+                        settings.k_v),
+        PilonsCorrection(settings.k_correction, 0.5_in),
+        SimpleStop(settings.harsh_threshold, settings.coast_threshold,
+                   settings.coast_power, 3_s),
+        waypoint));
+  reckless->go(path);
+
+  RunResult result{settings, 0_s, 0_in, false};
+  while (!reckless->is_completed() && result.time < TIME_LIMIT) {
+    clock->advance(TIMESTEP);
+    result.time += TIMESTEP;
+    sim->step();
+    reckless->step();
+  }
+  result.completed = reckless->is_completed();
+
+  // Let the robot come to rest before measuring where it ended up
+  for (int i = 0; i < 100; i++) {
+    clock->advance(TIMESTEP);
+    sim->step();
+  }
+  result.final_error = abs(sim->get_state().pos - waypoints[11]);
+
+  set_clock(nullptr);
+  return result;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  double time_limit = argc > 1 ? std::atof(argv[1]) : 0.0;
+
+  std::vector<Settings> sweep;
+  for (double k_v : {0.04, 0.06, 0.07, 0.08, 0.1, 0.12})
+    for (double k_correction : {2.0, 4.0, 8.0})
+      for (QTime harsh : {0.02_s, 0.03_s, 0.05_s})
+        for (QTime coast : {0.05_s, 0.1_s, 0.15_s, 0.2_s, 0.3_s})
+          for (double coast_power : {0.1, 0.2, 0.3, 0.4})
+            sweep.push_back({k_v, k_correction, harsh, coast, coast_power});
+
+  // Reckless reports each state change, which would bury the results
+  std::stringstream discard;
+  std::streambuf* cout_buffer = std::cout.rdbuf(discard.rdbuf());
+
+  std::vector<RunResult> results;
+  QTime simulated = 0_s;
+  auto start = std::chrono::steady_clock::now();
+  for (const Settings& settings : sweep) {
+    results.push_back(run(settings));
+    simulated += results.back().time;
+  }
+  double elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  std::cout.rdbuf(cout_buffer);
+
+  std::sort(results.begin(), results.end(),
+            [](const RunResult& a, const RunResult& b) {
+              if (a.completed != b.completed)
+                return a.completed;
+              return a.score() < b.score();
+            });
+
+  std::printf("%zu settings in %.2f s: %.0f routes/s, %.0fx real time\n\n",
+              results.size(), elapsed, results.size() / elapsed,
+              simulated.convert(second) / elapsed);
+  std::printf("%6s %6s %7s %7s %6s %9s %14s\n", "k_v", "k_corr", "harsh",
+              "coast", "power", "time (s)", "final err (in)");
+  for (size_t i = 0; i < std::min<size_t>(results.size(), 5); i++) {
+    const RunResult& result = results[i];
+    std::printf("%6.2f %6.1f %7.2f %7.2f %6.1f %9.2f %14.2f\n",
+                result.settings.k_v, result.settings.k_correction,
+                result.settings.harsh_threshold.convert(second),
+                result.settings.coast_threshold.convert(second),
+                result.settings.coast_power, result.time.convert(second),
+                result.final_error.convert(inch));
+  }
+
+  const RunResult& best = results.front();
+  if (!best.completed ||
+      (time_limit > 0 && best.time.convert(second) > time_limit)) {
+    std::printf("no setting drove the route in time\n");
+    return 1;
+  }
+  return 0;
+}
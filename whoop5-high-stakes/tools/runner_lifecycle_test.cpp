@@ -0,0 +1,273 @@
+// Checks AsyncRunner and Scheduler start, stop and pause behaviour.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "rev/api/async/async_runner.hh"
+#include "rev/api/async/rtos_time.hh"
+#include "rev/api/async/scheduler.hh"
+
+using namespace rev;
+
+namespace {
+int failures = 0;
+
+#define CHECK(condition)                                            \
+  do {                                                              \
+    if (!(condition)) {                                             \
+      std::printf("  FAILED line %d: %s\n", __LINE__, #condition); \
+      failures++;                                                   \
+    }                                                               \
+  } while (0)
+
+/**
+ * @brief Counts its steps, and can be told to take a while or to pause its
+ * own runner
+ *
+ */
+class CountingRunnable : public AsyncRunnable {
+ public:
+  void step() override {
+    in_step = true;
+    steps++;
+    if (step_time)
+      rtos_delay(step_time);
+    if (pause_self && steps == pause_at)
+      pause_self();
+    in_step = false;
+  }
+
+  std::atomic<int> steps{0};
+  std::atomic<bool> in_step{false};
+  uint32_t step_time{0};
+  int pause_at{0};
+  std::function<void()> pause_self;
+};
+
+void test_runner_start_stop() {
+  std::printf("runner start and stop\n");
+  auto counter = std::make_shared<CountingRunnable>();
+  AsyncRunner runner(counter, 2);
+  CHECK(runner.is_running());
+
+  runner.start();
+  rtos_delay(20);
+  runner.stop_and_join();
+  runner.stop_and_join();
+  CHECK(!runner.is_running());
+
+  int steps = counter->steps;
+  CHECK(steps > 0);
+  rtos_delay(20);
+  CHECK(counter->steps == steps);
+
+  runner.start();
+  rtos_delay(20);
+  CHECK(runner.is_running());
+  CHECK(counter->steps > steps);
+}
+
+void test_runner_pause_waits() {
+  std::printf("runner pause waits for the step in progress\n");
+  auto counter = std::make_shared<CountingRunnable>();
+  counter->step_time = 20;
+  AsyncRunner runner(counter, 2);
+
+  while (!counter->in_step)
+    std::this_thread::yield();
+  runner.pause();
+  CHECK(!counter->in_step);
+  CHECK(runner.is_paused());
+
+  int steps = counter->steps;
+  rtos_delay(50);
+  CHECK(counter->steps == steps);
+
+  runner.resume();
+  rtos_delay(50);
+  CHECK(counter->steps > steps);
+}
+
+void test_runner_pause_not_missed() {
+  std::printf("runner time spent paused is not a missed deadline\n");
+  auto counter = std::make_shared<CountingRunnable>();
+  AsyncRunner runner(counter, 5);
+  rtos_delay(20);
+  runner.pause();
+  runner.reset_stats();
+  rtos_delay(50);
+  runner.resume();
+  rtos_delay(20);
+  CHECK(runner.get_stats().steps > 0);
+  CHECK(runner.get_stats().missed_deadlines == 0);
+}
+
+void test_runner_pause_from_step() {
+  std::printf("runner paused from inside its own step\n");
+  auto counter = std::make_shared<CountingRunnable>();
+  AsyncRunner runner(counter, 2);
+
+  // The runner starts stepping straight away, so set up while it is paused
+  runner.pause();
+  counter->pause_at = counter->steps + 3;
+  counter->pause_self = [&runner] { runner.pause(); };
+  runner.resume();
+
+  rtos_delay(50);
+  CHECK(runner.is_paused());
+  CHECK(counter->steps == counter->pause_at);
+  runner.resume();
+  rtos_delay(20);
+  CHECK(counter->steps > counter->pause_at);
+}
+
+void test_runner_concurrent_lifecycle() {
+  std::printf("runner lifecycle called from several threads\n");
+  auto counter = std::make_shared<CountingRunnable>();
+  AsyncRunner runner(counter, 1);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&runner, i] {
+      for (int j = 0; j < 200; j++) {
+        switch ((i + j) % 4) {
+          case 0:
+            runner.start();
+            break;
+          case 1:
+            runner.pause();
+            break;
+          case 2:
+            runner.resume();
+            break;
+          case 3:
+            runner.stop_and_join();
+            break;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  runner.start();
+  runner.resume();
+  int steps = counter->steps;
+  rtos_delay(20);
+  CHECK(runner.is_running());
+  CHECK(counter->steps > steps);
+}
+
+void test_scheduler_pause_one() {
+  std::printf("scheduler pauses one runnable\n");
+  auto paused = std::make_shared<CountingRunnable>();
+  auto running = std::make_shared<CountingRunnable>();
+  Scheduler scheduler;
+  scheduler.add(paused, CONTROLLER_ORDER, 2).add(running, ODOMETRY_ORDER, 2);
+  rtos_delay(20);
+
+  scheduler.pause(paused);
+  int paused_steps = paused->steps;
+  int running_steps = running->steps;
+  rtos_delay(20);
+  CHECK(paused->steps == paused_steps);
+  CHECK(running->steps > running_steps);
+
+  scheduler.resume(paused);
+  rtos_delay(20);
+  CHECK(paused->steps > paused_steps);
+  CHECK(scheduler.get_stats(paused).missed_deadlines == 0);
+}
+
+void test_scheduler_restart() {
+  std::printf("scheduler keeps its runnables across stop and start\n");
+  auto counter = std::make_shared<CountingRunnable>();
+  Scheduler scheduler;
+  scheduler.add(counter, CONTROLLER_ORDER, 2);
+  rtos_delay(20);
+
+  scheduler.stop_and_join();
+  scheduler.stop_and_join();
+  CHECK(!scheduler.is_running());
+  int steps = counter->steps;
+  rtos_delay(20);
+  CHECK(counter->steps == steps);
+
+  scheduler.start();
+  scheduler.start();
+  rtos_delay(20);
+  CHECK(counter->steps > steps);
+
+  scheduler.remove(counter);
+  steps = counter->steps;
+  rtos_delay(20);
+  CHECK(counter->steps == steps);
+}
+
+void test_scheduler_pause_from_step() {
+  std::printf("scheduler paused from inside a step\n");
+  auto counter = std::make_shared<CountingRunnable>();
+  Scheduler scheduler;
+  counter->pause_at = 3;
+  counter->pause_self = [&scheduler] { scheduler.pause(); };
+  scheduler.add(counter, CONTROLLER_ORDER, 2);
+
+  rtos_delay(50);
+  CHECK(counter->steps == 3);
+  scheduler.resume();
+  rtos_delay(20);
+  CHECK(counter->steps > 3);
+}
+
+void time_mode_change() {
+  const int changes = 100;
+  auto counter = std::make_shared<CountingRunnable>();
+
+  auto start = std::chrono::steady_clock::now();
+  {
+    AsyncRunner runner(counter, 10);
+    for (int i = 0; i < changes; i++) {
+      runner.pause();
+      runner.resume();
+    }
+  }
+  double pausing = std::chrono::duration<double, std::micro>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < changes; i++) {
+    AsyncRunner runner(counter, 10);
+  }
+  double recreating = std::chrono::duration<double, std::micro>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+
+  std::printf("mode change: pause and resume %.1f us, recreate runner %.1f us\n",
+              pausing / changes, recreating / changes);
+}
+}  // namespace
+
+int main() {
+  test_runner_start_stop();
+  test_runner_pause_waits();
+  test_runner_pause_not_missed();
+  test_runner_pause_from_step();
+  test_runner_concurrent_lifecycle();
+  test_scheduler_pause_one();
+  test_scheduler_restart();
+  test_scheduler_pause_from_step();
+  time_mode_change();
+
+  if (failures) {
+    std::printf("%d checks failed\n", failures);
+    return 1;
+  }
+  std::printf("all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,109 @@
+// Measures period jitter on a Scheduler against one AsyncRunner each.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "rev/api/async/async_runner.hh"
+#include "rev/api/async/rtos_time.hh"
+#include "rev/api/async/scheduler.hh"
+
+using namespace rev;
+
+namespace {
+/**
+ * @brief Records when each of its steps started, and optionally spins to
+ * stand in for real work
+ *
+ */
+class TimedRunnable : public AsyncRunnable {
+ public:
+  TimedRunnable(const char* iname, uint32_t iperiod, uint64_t iload_us)
+      : name(iname), period(iperiod), load_us(iload_us) {}
+
+  void step() override {
+    uint64_t start = rtos_micros();
+    starts.push_back(start);
+    while (rtos_micros() - start < load_us) {
+    }
+  }
+
+  const char* name;
+  uint32_t period;  // Nominal period in millis
+  uint64_t load_us;
+  std::vector<uint64_t> starts;
+};
+
+void report(const TimedRunnable& runnable, const RunnerStats& stats) {
+  std::vector<double> errors;
+  for (size_t i = 1; i < runnable.starts.size(); i++) {
+    double period_ms = (runnable.starts[i] - runnable.starts[i - 1]) / 1000.0;
+    errors.push_back(std::abs(period_ms - runnable.period));
+  }
+  if (errors.empty()) {
+    std::printf("  %-12s no steps\n", runnable.name);
+    return;
+  }
+
+  std::sort(errors.begin(), errors.end());
+  auto percentile = [&](double p) {
+    return errors[std::min(errors.size() - 1,
+                           static_cast<size_t>(p * errors.size()))];
+  };
+  std::printf("  %-12s %6u %9.3f %9.3f %9.3f %8u %9.3f\n", runnable.name,
+              stats.steps, percentile(0.5), percentile(0.99), errors.back(),
+              stats.missed_deadlines, stats.step_max.convert(millisecond));
+}
+
+void header(const char* title) {
+  std::printf("%s\n  %-12s %6s %9s %9s %9s %8s %9s\n", title, "runnable",
+              "steps", "p50 (ms)", "p99 (ms)", "max (ms)", "missed",
+              "step (ms)");
+}
+
+std::vector<std::shared_ptr<TimedRunnable>> make_runnables(uint64_t load_us) {
+  return {std::make_shared<TimedRunnable>("odometry", 2, 50),
+          std::make_shared<TimedRunnable>("reckless", 10, load_us),
+          std::make_shared<TimedRunnable>("turn", 10, 50)};
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t duration = (argc > 1 ? std::atof(argv[1]) : 5.0) * 1000;
+  uint64_t load_us = argc > 2 ? std::atoi(argv[2]) : 500;
+
+  {
+    auto runnables = make_runnables(load_us);
+    Scheduler scheduler;
+    scheduler.pause();
+    scheduler.add(runnables[0], ODOMETRY_ORDER, runnables[0]->period);
+    scheduler.add(runnables[1], CONTROLLER_ORDER, runnables[1]->period);
+    scheduler.add(runnables[2], CONTROLLER_ORDER, runnables[2]->period);
+    scheduler.resume();
+    rtos_delay(duration);
+    scheduler.stop_and_join();
+
+    header("one scheduler thread, period error");
+    for (auto& runnable : runnables)
+      report(*runnable, scheduler.get_stats(runnable));
+  }
+
+  {
+    auto runnables = make_runnables(load_us);
+    std::vector<std::unique_ptr<AsyncRunner>> runners;
+    for (auto& runnable : runnables)
+      runners.push_back(
+          std::make_unique<AsyncRunner>(runnable, runnable->period));
+    rtos_delay(duration);
+    for (auto& runner : runners)
+      runner->stop_and_join();
+
+    header("one runner thread each, period error");
+    for (size_t i = 0; i < runnables.size(); i++)
+      report(*runnables[i], runners[i]->get_stats());
+  }
+  return 0;
+}
@@ -0,0 +1,288 @@
+// Measures a Reckless step's strategy work with SegmentFrame and without.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "rev/api/alg/drive/correction/pilons_correction.hh"
+#include "rev/api/alg/drive/motion/cascading_motion.hh"
+#include "rev/api/alg/drive/segment_frame.hh"
+#include "rev/api/alg/drive/stop/simple_stop.hh"
+#include "rev/util/mathutil.hh"
+
+using namespace rev;
+
+namespace {
+const int STATES = 4096;
+const int ROUNDS = 500;
+
+/**
+ * @brief Folds an angle onto the nearest half turn from a reference
+ *
+ */
+double nearest_semicircle(double angle, double reference) {
+  return angle + std::round((reference - angle) / M_PI) * M_PI;
+}
+
+/**
+ * @brief CascadingMotion as it was, measuring the target itself
+ *
+ */
+class LegacyCascadingMotion {
+ public:
+  LegacyCascadingMotion(double ipower, double ik_p, double ik_b)
+      : power(ipower), k_p(ik_p), k_b(ik_b) {}
+
+  virtual ~LegacyCascadingMotion() = default;
+
+  virtual std::tuple<double, double> gen_powers(OdometryState current_state,
+                                                Position target_point,
+                                                Position start_point,
+                                                QLength drop_early) {
+    (void)start_point;
+    QAngle angle_to_target = atan2(target_point.y - current_state.pos.y,
+                                   target_point.x - current_state.pos.x);
+    QLength distance = sqrt(
+        (target_point.x - current_state.pos.x) *
+            (target_point.x - current_state.pos.x) +
+        (target_point.y - current_state.pos.y) *
+            (target_point.y - current_state.pos.y));
+    double heading_cos =
+        cos(current_state.pos.theta - angle_to_target).get_value();
+    QLength error = distance * heading_cos - sgn(heading_cos) * drop_early;
+
+    QSpeed v = cos(current_state.pos.theta).get_value() * current_state.vel.xv +
+               sin(current_state.pos.theta).get_value() * current_state.vel.yv;
+    QSpeed v_target = sgn(error.get_value()) *
+                      (1 - std::exp(-k_v * abs(error).convert(inch))) * max_v;
+    double out = std::clamp(k_b * v_target.convert(inch / second) +
+                                k_p * (v_target - v).convert(inch / second),
+                            -power, power);
+    return std::make_tuple(out, out);
+  }
+
+ private:
+  double power;
+  double k_p;
+  double k_b;
+  QSpeed max_v{60 * inch / second};
+  double k_v{0.07};
+};
+
+/**
+ * @brief PilonsCorrection as it was, building the target line itself
+ *
+ */
+class LegacyPilonsCorrection {
+ public:
+  LegacyPilonsCorrection(double ik_correction, QLength imax_error)
+      : k_correction(ik_correction), max_error(imax_error) {}
+
+  virtual ~LegacyPilonsCorrection() = default;
+
+  virtual std::tuple<double, double> apply_correction(
+      OdometryState current_state,
+      Position target_point,
+      Position start_point,
+      QLength drop_early,
+      std::tuple<double, double> powers) {
+    (void)drop_early;
+    Position target_line = target_point;
+    target_line.theta =
+        nearest_semicircle(
+            std::atan2((target_point.y - start_point.y).get_value(),
+                       (target_point.x - start_point.x).get_value()),
+            start_point.theta.convert(radian)) *
+        radian;
+    Position relative = current_state.pos.to_relative(target_line);
+    double theta = relative.theta.convert(radian);
+    double angle = nearest_semicircle(
+        std::atan2(relative.y.get_value(), relative.x.get_value()) - theta, 0);
+    QLength xerr = abs(relative.y + std::tan(theta) * relative.x);
+
+    double correction = abs(max_error) < xerr ? angle * k_correction : 0;
+    double left = std::get<0>(powers);
+    double right = std::get<1>(powers);
+    if (left < 0)
+      correction = -correction;
+    if (correction > 0)
+      right *= std::exp(-correction);
+    else if (correction < 0)
+      left *= std::exp(correction);
+    return std::make_tuple(left, right);
+  }
+
+ private:
+  double k_correction;
+  QLength max_error;
+};
+
+/**
+ * @brief SimpleStop as it was, measuring the distance remaining itself
+ *
+ */
+class LegacySimpleStop {
+ public:
+  LegacySimpleStop(QTime iharsh_threshold, QTime icoast_threshold)
+      : harsh_threshold(iharsh_threshold), coast_threshold(icoast_threshold) {}
+
+  virtual ~LegacySimpleStop() = default;
+
+  virtual stop_state get_stop_state(OdometryState current_state,
+                                    Position target_point,
+                                    Position start_point,
+                                    QLength drop_early) {
+    QSpeed speed = sqrt(current_state.vel.xv * current_state.vel.xv +
+                        current_state.vel.yv * current_state.vel.yv);
+    QLength distance_remaining =
+        distance_to_drop(current_state, target_point, start_point, drop_early);
+
+    if (distance_remaining < 0_m) {
+      stop_state_last = stop_state::BRAKE;
+      return stop_state::BRAKE;
+    }
+    if (distance_remaining < speed * harsh_threshold ||
+        stop_state_last == stop_state::BRAKE) {
+      stop_state_last = stop_state::BRAKE;
+      return stop_state::BRAKE;
+    }
+    if (distance_remaining < speed * coast_threshold ||
+        stop_state_last == stop_state::COAST) {
+      stop_state_last = stop_state::COAST;
+      return stop_state::COAST;
+    }
+    return stop_state::GO;
+  }
+
+  static QLength distance_to_drop(const OdometryState& current_state,
+                                  Position target_point,
+                                  Position start_point,
+                                  QLength drop_early) {
+    Position target_line = target_point;
+    target_line.theta = atan2(target_point.y - start_point.y,
+                              target_point.x - start_point.x);
+    return -1 * current_state.pos.to_relative(target_line).x - drop_early;
+  }
+
+ private:
+  QTime harsh_threshold;
+  QTime coast_threshold;
+  stop_state stop_state_last{stop_state::GO};
+};
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+}  // namespace
+
+int main() {
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+  // Robots scattered around a segment, heading every which way
+  std::vector<OdometryState> states;
+  for (int i = 0; i < STATES; i++) {
+    OdometryState state{{uniform(random) * 48_in, uniform(random) * 48_in,
+                         uniform(random) * 180_deg},
+                        {uniform(random) * 60 * inch / second,
+                         uniform(random) * 60 * inch / second,
+                         0 * radian / second}};
+    states.push_back(state);
+  }
+  const Position start{0_in, 0_in, 0_deg};
+  const Position target{40_in, 12_in, 0_deg};
+  const QLength drop_early = 2_in;
+
+  // Called through pointers, as Reckless calls both kinds of strategy
+  std::unique_ptr<LegacyCascadingMotion> legacy_motion =
+      std::make_unique<LegacyCascadingMotion>(0.8, 0.05, 0.015);
+  std::unique_ptr<LegacyPilonsCorrection> legacy_correction =
+      std::make_unique<LegacyPilonsCorrection>(2.0, 0.5_in);
+  std::unique_ptr<LegacySimpleStop> legacy_stop =
+      std::make_unique<LegacySimpleStop>(0.1_s, 0.25_s);
+  std::unique_ptr<Motion> motion =
+      std::make_unique<CascadingMotion>(0.8, 0.05, 0.015);
+  std::unique_ptr<Correction> correction =
+      std::make_unique<PilonsCorrection>(2.0, 0.5_in);
+  std::unique_ptr<Stop> stop = std::make_unique<SimpleStop>(0.1_s, 0.25_s, 0.2);
+
+  SegmentFrame frame;
+  frame.begin(start, target, drop_early);
+
+  double power_difference = 0;
+  double distance_difference = 0;
+  for (const OdometryState& state : states) {
+    auto legacy = legacy_correction->apply_correction(
+        state, target, start, drop_early,
+        legacy_motion->gen_powers(state, target, start, drop_early));
+    frame.update(state);
+    auto powers =
+        correction->apply_correction(frame, motion->gen_powers(frame));
+    power_difference = std::max(
+        {power_difference, std::abs(std::get<0>(legacy) - std::get<0>(powers)),
+         std::abs(std::get<1>(legacy) - std::get<1>(powers))});
+    distance_difference = std::max(
+        distance_difference,
+        std::abs((LegacySimpleStop::distance_to_drop(state, target, start,
+                                                     drop_early) -
+                  frame.distance_remaining)
+                     .convert(inch)));
+  }
+  std::printf("largest difference: %.3g power, %.3g in remaining\n\n",
+              power_difference, distance_difference);
+
+  // Both stops latch into braking as they do on the robot, so each round
+  // starts them over
+  std::printf("%-8s %16s %16s\n", "round", "legacy (ns)", "frame (ns)");
+  double sink = 0;
+  double best_legacy = INFINITY, best_frame = INFINITY;
+  for (int round = 0; round < 3; round++) {
+    auto legacy_start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++) {
+      legacy_stop = std::make_unique<LegacySimpleStop>(0.1_s, 0.25_s);
+      for (const OdometryState& state : states) {
+        stop_state stop_state =
+            legacy_stop->get_stop_state(state, target, start, drop_early);
+        auto powers = legacy_correction->apply_correction(
+            state, target, start, drop_early,
+            legacy_motion->gen_powers(state, target, start, drop_early));
+        sink += std::get<0>(powers) + static_cast<int>(stop_state);
+      }
+    }
+    double legacy_ns = seconds_since(legacy_start) * 1e9 / (ROUNDS * STATES);
+
+    auto frame_start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++) {
+      stop = std::make_unique<SimpleStop>(0.1_s, 0.25_s, 0.2);
+      frame.begin(start, target, drop_early);
+      for (const OdometryState& state : states) {
+        frame.update(state);
+        stop_state stop_state = stop->get_stop_state(frame);
+        auto powers =
+            correction->apply_correction(frame, motion->gen_powers(frame));
+        sink += std::get<0>(powers) + static_cast<int>(stop_state);
+      }
+    }
+    double frame_ns = seconds_since(frame_start) * 1e9 / (ROUNDS * STATES);
+
+    std::printf("%-8d %16.1f %16.1f\n", round + 1, legacy_ns, frame_ns);
+    best_legacy = std::min(best_legacy, legacy_ns);
+    best_frame = std::min(best_frame, frame_ns);
+  }
+  std::printf("\nbest: legacy %.1f ns, frame %.1f ns per step, %.0f%% less "
+              "(checksum %.0f)\n",
+              best_legacy, best_frame, 100 * (1 - best_frame / best_legacy),
+              sink);
+
+  bool ok = power_difference < 1e-9 && distance_difference < 1e-9;
+  if (!ok)
+    std::printf("the frame does not match the old strategies\n");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+// Measures allocations and steps of strategies by value and by shared_ptr.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "rev/api/alg/reckless/reckless.hh"
+
+using namespace rev;
+
+namespace {
+const int SEGMENTS = 30;
+const int STEPS = 1000000;
+const int ROUNDS = 5;
+
+size_t allocations = 0;
+}  // namespace
+
+// Every heap allocation in the program goes through these. They are kept out
+// of line, since GCC warns about free() on memory from new once inlined.
+__attribute__((noinline)) void* operator new(size_t size) {
+  allocations++;
+  if (void* memory = std::malloc(size))
+    return memory;
+  throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+  operator delete(memory);
+}
+
+namespace {
+/**
+ * @brief Chassis which only adds up the powers it is given
+ *
+ */
+class NullChassis : public Chassis {
+ public:
+  void drive_tank(double left, double right) override { sink += left + right; }
+  void drive_arcade(double forward, double yaw) override {
+    sink += forward + yaw;
+  }
+  void set_brake_harsh() override {}
+  void set_brake_coast() override {}
+  void stop() override {}
+
+  double sink{0};
+};
+
+/**
+ * @brief Odometry which replays a fixed list of states
+ *
+ */
+class ReplayOdometry : public Odometry {
+ public:
+  explicit ReplayOdometry(std::vector<OdometryState> istates)
+      : states(std::move(istates)) {}
+
+  OdometryState get_state() override {
+    next = next + 1 == states.size() ? 0 : next + 1;
+    return states[next];
+  }
+  void set_position(Position) override {}
+  void reset_position() override {}
+
+ private:
+  std::vector<OdometryState> states;
+  size_t next{0};
+};
+
+RecklessPath make_path(bool by_value) {
+  RecklessPath path;
+  for (int i = 0; i < SEGMENTS; i++) {
+    // Far enough off that the first segment never finishes
+    Position target{(1000 + i) * inch, 0_in, 0_deg};
+    if (by_value)
+      path.with_segment(RecklessPathSegment(
+          CascadingMotion(0.8, 0.05, 0.015), PilonsCorrection(2, 0.5_in),
+          SimpleStop(0.1_s, 0.25_s, 0.2), target));
+    else
+      path.with_segment(RecklessPathSegment(
+          std::make_shared<CascadingMotion>(0.8, 0.05, 0.015),
+          std::make_shared<PilonsCorrection>(2, 0.5_in),
+          std::make_shared<SimpleStop>(0.1_s, 0.25_s, 0.2), target));
+  }
+  return path;
+}
+
+struct Result {
+  size_t build_allocations{0};
+  size_t step_allocations{0};
+  double step_ns{INFINITY};
+};
+
+void time_steps(Reckless& reckless, RecklessPath& path, Result& result) {
+  reckless.go(path);
+  size_t before = allocations;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < STEPS; i++)
+    reckless.step();
+  double elapsed = std::chrono::duration<double, std::nano>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  result.step_allocations += allocations - before;
+  result.step_ns = std::min(result.step_ns, elapsed / STEPS);
+  reckless.breakout();
+}
+}  // namespace
+
+int main() {
+  // Slowly creeping forward near the start of the first segment, weaving a
+  // little so the correction has something to do
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  std::vector<OdometryState> states;
+  for (int i = 0; i < 4096; i++)
+    states.push_back({{uniform(random) * 10_in, uniform(random) * 10_in,
+                       uniform(random) * 20_deg},
+                      {(0.5 + uniform(random) * 0.1) * inch / second,
+                       uniform(random) * 0.1 * inch / second,
+                       0 * radian / second}});
+
+  auto chassis = std::make_shared<NullChassis>();
+  Reckless reckless(chassis, std::make_shared<ReplayOdometry>(states));
+
+  // Reckless reports each state change, which would bury the results
+  std::stringstream discard;
+  std::streambuf* cout_buffer = std::cout.rdbuf(discard.rdbuf());
+  Result values, pointers;
+  size_t before = allocations;
+  RecklessPath value_path = make_path(true);
+  values.build_allocations = allocations - before;
+  before = allocations;
+  RecklessPath pointer_path = make_path(false);
+  pointers.build_allocations = allocations - before;
+
+  // Taking turns, so that neither gets the warmer cache throughout
+  for (int round = 0; round < ROUNDS; round++) {
+    time_steps(reckless, value_path, values);
+    time_steps(reckless, pointer_path, pointers);
+  }
+  std::cout.rdbuf(cout_buffer);
+
+  std::printf("%d segments, best of %d rounds of %d steps\n\n", SEGMENTS,
+              ROUNDS, STEPS);
+  std::printf("%-12s %18s %18s %12s\n", "strategies", "build allocations",
+              "step allocations", "step (ns)");
+  std::printf("%-12s %18zu %18zu %12.1f\n", "by value",
+              values.build_allocations, values.step_allocations,
+              values.step_ns);
+  std::printf("%-12s %18zu %18zu %12.1f\n", "shared_ptr",
+              pointers.build_allocations, pointers.step_allocations,
+              pointers.step_ns);
+  std::printf("\n(checksum %.0f)\n", chassis->sink);
+
+  bool ok = values.build_allocations == 0 && values.step_allocations == 0;
+  if (!ok)
+    std::printf("the path of values allocated\n");
+  return ok ? 0 : 1;
+}
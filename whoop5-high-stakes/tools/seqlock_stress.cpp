@@ -0,0 +1,161 @@
+// Checks Seqlock reads are never torn, and times it against a mutex.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rev/api/alg/odometry/odometry.hh"
+#include "rev/api/async/seqlock.hh"
+
+using namespace rev;
+
+namespace {
+using steady = std::chrono::steady_clock;
+
+// Every field is a different function of n, so a snapshot mixing two
+// publishes can't pass check()
+OdometryState make_state(uint32_t n) {
+  double v = n;
+  return {{v * meter, -2 * v * meter, 3 * v * radian},
+          {4 * v * mps, -5 * v * mps, 6 * v * radian / second}};
+}
+
+bool check(const OdometryState& state, uint32_t& n) {
+  double v = state.pos.x.convert(meter);
+  n = static_cast<uint32_t>(v);
+  return v == n && state.pos.y.convert(meter) == -2 * v &&
+         state.pos.theta.convert(radian) == 3 * v &&
+         state.vel.xv.convert(mps) == 4 * v &&
+         state.vel.yv.convert(mps) == -5 * v &&
+         state.vel.angular.convert(radian / second) == 6 * v;
+}
+
+/**
+ * @brief The same interface as Seqlock, behind a mutex
+ *
+ */
+template <typename T>
+class MutexBox {
+ public:
+  explicit MutexBox(const T& initial) : value(initial) {}
+
+  void write(const T& ivalue) {
+    std::lock_guard<std::mutex> lock(mutex);
+    value = ivalue;
+  }
+
+  T read() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return value;
+  }
+
+ private:
+  mutable std::mutex mutex;
+  T value;
+};
+
+bool stress(int readers, double seconds) {
+  Seqlock<OdometryState> published(make_state(0));
+  std::atomic<bool> running{true};
+  std::atomic<uint64_t> torn{0};
+  std::atomic<uint64_t> backwards{0};
+  std::atomic<uint64_t> reads{0};
+
+  std::thread writer([&] {
+    for (uint32_t n = 1; running; n++)
+      published.write(make_state(n));
+  });
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < readers; i++) {
+    threads.emplace_back([&] {
+      uint32_t last = 0;
+      uint64_t count = 0;
+      while (running) {
+        uint32_t n;
+        if (!check(published.read(), n))
+          torn++;
+        else if (n < last)
+          backwards++;
+        last = std::max(last, n);
+        count++;
+      }
+      reads += count;
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+  running = false;
+  writer.join();
+  for (auto& thread : threads)
+    thread.join();
+
+  std::printf(
+      "stress: %d readers, %llu reads, %llu torn, %llu went backwards\n",
+      readers, (unsigned long long)reads.load(),
+      (unsigned long long)torn.load(), (unsigned long long)backwards.load());
+  return torn == 0 && backwards == 0;
+}
+
+template <typename Box>
+void contend(const char* name, int readers) {
+  Box published(make_state(0));
+  std::atomic<bool> running{true};
+  std::atomic<uint64_t> reads{0};
+  std::vector<double> write_times;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < readers; i++) {
+    threads.emplace_back([&] {
+      uint64_t count = 0;
+      uint32_t n;
+      while (running) {
+        check(published.read(), n);
+        count++;
+      }
+      reads += count;
+    });
+  }
+
+  // A writer much faster than odometry's, so there are enough writes to see
+  // how long one can be held up
+  const auto duration = std::chrono::seconds(1);
+  auto start = steady::now();
+  for (uint32_t n = 1; steady::now() - start < duration; n++) {
+    auto before = steady::now();
+    published.write(make_state(n));
+    write_times.push_back(
+        std::chrono::duration<double, std::micro>(steady::now() - before)
+            .count());
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  running = false;
+  for (auto& thread : threads)
+    thread.join();
+
+  std::sort(write_times.begin(), write_times.end());
+  std::printf("%-8s %8d %16.1f %14.2f %14.2f\n", name, readers,
+              reads / 1e6 / readers,
+              write_times[write_times.size() * 99 / 100], write_times.back());
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  int readers = std::max(argc > 1 ? std::atoi(argv[1]) : 8, 1);
+  double seconds = argc > 2 ? std::atof(argv[2]) : 5.0;
+
+  bool ok = stress(readers, seconds);
+
+  std::printf("\n%-8s %8s %16s %14s %14s\n", "", "readers",
+              "Mreads/s/reader", "write p99 (us)", "write max (us)");
+  for (int count : {1, 2, 4, 8}) {
+    contend<MutexBox<OdometryState>>("mutex", count);
+    contend<Seqlock<OdometryState>>("seqlock", count);
+  }
+  return ok ? 0 : 1;
+}
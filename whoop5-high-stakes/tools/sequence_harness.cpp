@@ -0,0 +1,292 @@
+// Checks the order Sequencer actions end in, races and cancelling.
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "rev/api/alg/sequence/actions.hh"
+#include "rev/api/alg/sequence/sequencer.hh"
+#include "rev/api/async/clock.hh"
+#include "rev/api/hardware/chassis_sim/driftless_sim.hh"
+
+using namespace rev;
+
+namespace {
+const QTime TIMESTEP = 10_ms;
+const int MAX_TICKS = 2000;
+
+bool failed = false;
+
+void expect(bool condition, const char* what) {
+  std::printf("%-56s %s\n", what, condition ? "ok" : "FAILED");
+  failed = failed || !condition;
+}
+
+/**
+ * @brief Passes everything through to the sim, counting drive commands
+ *
+ */
+class WatchedChassis : public Chassis {
+ public:
+  explicit WatchedChassis(std::shared_ptr<Chassis> ichassis)
+      : chassis(ichassis) {}
+
+  void drive_tank(double left, double right) override {
+    drives++;
+    chassis->drive_tank(left, right);
+  }
+  void drive_arcade(double forward, double yaw) override {
+    drives++;
+    chassis->drive_arcade(forward, yaw);
+  }
+  void set_brake_harsh() override { chassis->set_brake_harsh(); }
+  void set_brake_coast() override { chassis->set_brake_coast(); }
+  void stop() override { chassis->stop(); }
+
+  int drives{0};
+
+ private:
+  std::shared_ptr<Chassis> chassis;
+};
+
+RecklessPathSegment make_segment(Position target) {
+  return RecklessPathSegment(
+      CascadingMotion(1.0, 0.02, 1.0 / 60), PilonsCorrection(4.0, 0.5_in),
+      SimpleStop(0.03_s, 0.15_s, 0.3), target, 1_in);
+}
+
+RecklessPath make_path(std::vector<Position> targets) {
+  RecklessPath path;
+  for (const Position& target : targets)
+    path.with_segment(make_segment(target));
+  return path;
+}
+
+/**
+ * @brief A robot with a Sequencer stepped ahead of its controllers, as the
+ * Scheduler orders them on the robot
+ *
+ */
+class Rig {
+ public:
+  Rig()
+      : clock(std::make_shared<VirtualClock>()),
+        sim(std::make_shared<DriftlessSim>(60 * inch / second,
+                                           10 * radian / second, 6_Hz, 8_Hz,
+                                           20_Hz, 20_Hz)),
+        chassis(std::make_shared<WatchedChassis>(sim)),
+        reckless(std::make_shared<Reckless>(chassis, sim)),
+        turn(std::make_shared<CampbellTurn>(chassis, sim, 0.18, 0.07)) {
+    set_clock(clock);
+  }
+
+  ~Rig() { set_clock(nullptr); }
+
+  void step() {
+    clock->advance(TIMESTEP);
+    sim->step();
+    sequencer.step();
+    reckless->step();
+    turn->step();
+    tick++;
+  }
+
+  /**
+   * @brief Steps until the routine is done
+   *
+   * @return false if it never finished
+   */
+  bool finish() {
+    while (!sequencer.is_completed() && tick < MAX_TICKS)
+      step();
+    return sequencer.is_completed();
+  }
+
+  /**
+   * @brief An action which notes the tick it ran on
+   *
+   */
+  std::shared_ptr<Action> note(const std::string& text) {
+    return run([this, text] { notes.push_back({tick, text}); });
+  }
+
+  /**
+   * @brief Runs something which never finishes by itself, noting when it
+   * starts and ends
+   *
+   */
+  std::shared_ptr<Action> intake() {
+    return run_until([this] { notes.push_back({tick, "intake on"}); },
+                     [] { return false; },
+                     [this] { notes.push_back({tick, "intake off"}); });
+  }
+
+  int tick_of(const std::string& text) const {
+    for (const auto& note : notes)
+      if (note.second == text)
+        return note.first;
+    return -1;
+  }
+
+  bool noted(std::vector<std::string> expected) const {
+    if (expected.size() != notes.size())
+      return false;
+    for (size_t i = 0; i < notes.size(); i++)
+      if (notes[i].second != expected[i])
+        return false;
+    return true;
+  }
+
+  void print_notes() const {
+    for (const auto& note : notes)
+      std::printf("  %5d  %s\n", note.first, note.second.c_str());
+  }
+
+  std::shared_ptr<VirtualClock> clock;
+  std::shared_ptr<DriftlessSim> sim;
+  std::shared_ptr<WatchedChassis> chassis;
+  std::shared_ptr<Reckless> reckless;
+  std::shared_ptr<CampbellTurn> turn;
+  Sequencer sequencer;
+  int tick{0};
+  std::vector<std::pair<int, std::string>> notes;  // Tick and what happened
+};
+
+/**
+ * @brief Drives a path while waiting on its progress, turns, runs the intake
+ * for a few ticks and waits, checking each ends in order
+ *
+ */
+void check_order() {
+  std::printf("sequence and parallel\n");
+  Rig rig;
+  int polls = 0;
+  rig.sequencer.run(sequence(
+      {rig.note("start"),
+       parallel({drive_path(rig.reckless,
+                            make_path({{24_in, 0_in, 0_deg},
+                                       {48_in, 0_in, 0_deg}})),
+                 sequence({wait_until_progress(rig.reckless, 0.5),
+                           rig.note("halfway along the first segment")}),
+                 sequence({wait_until_progress(rig.reckless, 1.0),
+                           rig.note("on the second segment")})}),
+       rig.note("driven"), turn_to(rig.turn, 0.6, 90_deg), rig.note("turned"),
+       run_until([&] { rig.notes.push_back({rig.tick, "intake on"}); },
+                 [&] { return ++polls >= 5; },
+                 [&] { rig.notes.push_back({rig.tick, "intake off"}); }),
+       wait_time(200_ms), rig.note("end")}));
+  bool finished = rig.finish();
+  rig.print_notes();
+
+  Position pos = rig.sim->get_state().pos;
+  expect(finished, "the routine finishes");
+  expect(rig.noted({"start", "halfway along the first segment",
+                    "on the second segment", "driven", "turned", "intake on",
+                    "intake off", "end"}),
+         "every action ends in order");
+  expect(rig.tick_of("start") == 0, "the first action runs on the first tick");
+  expect(rig.tick_of("halfway along the first segment") <
+                 rig.tick_of("on the second segment") &&
+             rig.tick_of("on the second segment") < rig.tick_of("driven"),
+         "progress waits end while the path is driven");
+  expect(rig.tick_of("intake off") - rig.tick_of("intake on") == 4,
+         "run_until ends on the tick its condition is true");
+  expect(rig.tick_of("end") - rig.tick_of("intake off") == 20,
+         "wait_time waits its time");
+  expect(abs(pos.x - 48_in) < 2_in && abs(pos.y) < 2_in,
+         "the path reaches its end");
+  expect(abs(pos.theta - 90_deg) < 10_deg, "the turn reaches its heading");
+}
+
+/**
+ * @brief Races a path too long to finish and an intake that never stops
+ * against a wait, checking the losers are cancelled when it ends
+ *
+ */
+void check_race() {
+  std::printf("\nrace\n");
+  Rig rig;
+  bool broken_out = false;
+  rig.sequencer.run(sequence(
+      {race({drive_path(rig.reckless, make_path({{200_in, 0_in, 0_deg}})),
+             rig.intake(), wait_time(500_ms)}),
+       run([&] { broken_out = rig.reckless->is_completed(); }),
+       rig.note("race over")}));
+  bool finished = rig.finish();
+  rig.print_notes();
+
+  expect(finished, "the race finishes");
+  expect(rig.noted({"intake on", "intake off", "race over"}),
+         "the losers are cancelled before what comes next");
+  expect(rig.tick_of("race over") == 50, "the race ends when the wait does");
+  expect(broken_out && rig.sim->get_state().pos.x < 100_in,
+         "the path is broken out short of its end");
+}
+
+/**
+ * @brief Cancels routines part way through a path and part way through a
+ * turn, checking the motion stops being driven
+ *
+ */
+void check_cancel() {
+  std::printf("\ncancel\n");
+  {
+    Rig rig;
+    rig.sequencer.run(
+        sequence({drive_path(rig.reckless, make_path({{200_in, 0_in, 0_deg}})),
+                  rig.note("path done")}));
+    for (int i = 0; i < 30; i++)
+      rig.step();
+    bool was_driving = !rig.reckless->is_completed();
+    rig.sequencer.cancel();
+    int drives = rig.chassis->drives;
+    for (int i = 0; i < 30; i++)
+      rig.step();
+
+    expect(was_driving, "the path is being driven before cancelling");
+    expect(rig.sequencer.is_completed() && rig.reckless->is_completed(),
+           "cancelling breaks out Reckless");
+    expect(rig.chassis->drives == drives && rig.notes.empty(),
+           "nothing is driven or run after cancelling");
+  }
+  {
+    Rig rig;
+    rig.sequencer.run(parallel({turn_to(rig.turn, 0.6, 180_deg), rig.intake()}));
+    for (int i = 0; i < 10; i++)
+      rig.step();
+    bool was_turning = !rig.turn->is_completed();
+    rig.sequencer.cancel();
+    int drives = rig.chassis->drives;
+    for (int i = 0; i < 100; i++)
+      rig.step();
+    rig.print_notes();
+
+    expect(was_turning, "the turn is running before cancelling");
+    expect(rig.sequencer.is_completed() && rig.turn->is_completed(),
+           "cancelling breaks out CampbellTurn");
+    expect(rig.chassis->drives == drives &&
+               abs(rig.sim->get_state().vel.angular) < 0.01 * radian / second,
+           "the chassis is stopped after cancelling");
+    expect(rig.noted({"intake on", "intake off"}),
+           "cancelling ends what runs alongside");
+  }
+}
+}  // namespace
+
+int main() {
+  // Reckless reports each state change, which would bury the results
+  std::stringstream discard;
+  std::streambuf* cout_buffer = std::cout.rdbuf(discard.rdbuf());
+  check_order();
+  check_race();
+  check_cancel();
+  std::cout.rdbuf(cout_buffer);
+
+  if (failed)
+    std::printf("\nthe routines did not run as built\n");
+  return failed ? 1 : 0;
+}
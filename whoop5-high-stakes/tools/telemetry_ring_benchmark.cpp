@@ -0,0 +1,146 @@
+// Measures TelemetryRing push and pop cost, throughput and drops.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+#include "rev/api/telemetry/telemetry.hh"
+
+using namespace rev;
+
+namespace {
+using steady = std::chrono::steady_clock;
+
+TelemetryRecord make_record(uint32_t n) {
+  return TelemetryRecord{n,
+                         {n * inch, 0_in, 0_deg},
+                         {0_mps, 0_mps, 0 * radian / second},
+                         0.5,
+                         0.5,
+                         stop_state::GO,
+                         n % 8};
+}
+
+double nanoseconds_since(steady::time_point start) {
+  return std::chrono::duration<double, std::nano>(steady::now() - start)
+      .count();
+}
+
+void single_thread() {
+  const uint32_t records = 10000000;
+  auto ring = std::make_unique<TelemetryRing>();
+  TelemetryRecord record = make_record(0);
+  uint64_t checksum = 0;
+
+  auto start = steady::now();
+  for (uint32_t i = 0; i < records; i++) {
+    ring->push(make_record(i));
+    ring->pop(record);
+    checksum += record.time;
+  }
+  double round_trip = nanoseconds_since(start) / records;
+
+  // Once full, every push is an overflow
+  start = steady::now();
+  for (uint32_t i = 0; i < records; i++)
+    ring->push(make_record(i));
+  double full_push = nanoseconds_since(start) / records;
+
+  std::printf("one thread: push+pop %.1f ns, push to a full ring %.1f ns, "
+              "%u overflows (checksum %llu)\n",
+              round_trip, full_push, ring->get_overflows(),
+              (unsigned long long)checksum);
+}
+
+void two_threads() {
+  const uint32_t records = 10000000;
+  auto ring = std::make_unique<TelemetryRing>();
+  std::atomic<bool> producing{true};
+  uint32_t received = 0;
+  uint32_t out_of_order = 0;
+
+  std::thread consumer([&] {
+    TelemetryRecord record = make_record(0);
+    uint32_t last = 0;
+    while (producing || ring->size() > 0) {
+      while (ring->pop(record)) {
+        if (received > 0 && record.time <= last)
+          out_of_order++;
+        last = record.time;
+        received++;
+      }
+      std::this_thread::yield();
+    }
+  });
+
+  // Retry when full, so every record gets through and the overflow count is
+  // how often the producer found the ring full
+  auto start = steady::now();
+  for (uint32_t i = 0; i < records; i++) {
+    while (!ring->push(make_record(i)))
+      std::this_thread::yield();
+  }
+  producing = false;
+  consumer.join();
+  double elapsed = nanoseconds_since(start);
+
+  std::printf("two threads: %.1f M records/s through, %u received, found "
+              "full %u times, %u out of order\n",
+              records / elapsed * 1000, received, ring->get_overflows(),
+              out_of_order);
+}
+
+/**
+ * @brief Counts the records dropped by a ring of capacity N, with one record
+ * per 10 ms tick and a drain every 50 ms that sometimes stalls
+ *
+ * @param stall_ticks How long each stall lasts
+ */
+template <size_t N>
+uint32_t dropped(uint32_t stall_ticks) {
+  auto ring = std::make_unique<SpscRing<TelemetryRecord, N>>();
+  TelemetryRecord record = make_record(0);
+
+  // A minute of ticks, with a stall starting every 10 seconds
+  for (uint32_t tick = 0; tick < 6000; tick++) {
+    ring->push(make_record(tick));
+    bool stalled = tick % 1000 < stall_ticks;
+    if (tick % 5 == 0 && !stalled) {
+      while (ring->pop(record)) {
+      }
+    }
+  }
+  return ring->get_overflows();
+}
+
+void sizing() {
+  std::printf("\nrecords dropped over a minute at 100Hz, with the drain "
+              "stalling every 10 s for\n%10s", "capacity");
+  const uint32_t stalls[] = {50, 100, 250, 500};
+  for (uint32_t stall : stalls)
+    std::printf(" %8.1fs", stall * 0.01);
+  std::printf("\n");
+
+  auto row = [&](size_t capacity, auto count) {
+    std::printf("%10zu", capacity);
+    for (uint32_t stall : stalls)
+      std::printf(" %9u", count(stall));
+    std::printf("\n");
+  };
+  row(64, dropped<64>);
+  row(128, dropped<128>);
+  row(256, dropped<256>);
+  row(512, dropped<512>);
+}
+}  // namespace
+
+int main() {
+  std::printf("TelemetryRecord is %zu bytes, TelemetryRing holds %zu\n",
+              sizeof(TelemetryRecord), TelemetryRing::capacity());
+  single_thread();
+  two_threads();
+  sizing();
+  return 0;
+}